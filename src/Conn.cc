@@ -214,9 +214,10 @@ const RecordValPtr& Connection::GetVal() {
         conn_val->Assign(0, std::move(id_val));
         conn_val->Assign(1, std::move(orig_endp));
         conn_val->Assign(2, std::move(resp_endp));
-        // 3 and 4 are set below.
-        conn_val->Assign(5, make_intrusive<TableVal>(id::string_set)); // service
-        conn_val->Assign(6, val_mgr->EmptyString());                   // history
+        // 3 and 4 are set below. The service set (5) gets created by the
+        // record type's deferred initialization on first access, as most
+        // connections never have a service assigned.
+        conn_val->Assign(6, val_mgr->EmptyString()); // history
 
         if ( ! uid )
             uid.Set(zeek::detail::bits_per_uid);
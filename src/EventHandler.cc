@@ -2,6 +2,7 @@
 
 #include "zeek/Desc.h"
 #include "zeek/Event.h"
+#include "zeek/EventTrace.h"
 #include "zeek/Func.h"
 #include "zeek/ID.h"
 #include "zeek/NetVar.h"
@@ -9,6 +10,7 @@
 #include "zeek/Var.h"
 #include "zeek/broker/Data.h"
 #include "zeek/broker/Manager.h"
+#include "zeek/plugin/Manager.h"
 #include "zeek/telemetry/Manager.h"
 
 namespace zeek {
@@ -115,4 +117,17 @@ void EventHandler::NewEvent(Args* vl) {
 
 uint64_t EventHandler::CallCount() const { return call_count ? call_count->Value() : 0; }
 
+bool EventHandler::ParamUsed(int idx) const {
+    if ( idx < 0 || idx >= static_cast<int>(param_usage.size()) || param_usage[idx] )
+        return true;
+
+    // Whatever sees the full argument list needs the real values.
+    if ( generate_always || ! auto_publish.empty() || new_event || detail::etm ||
+         plugin_mgr->HavePluginForHook(plugin::HOOK_QUEUE_EVENT) ||
+         plugin_mgr->HavePluginForHook(plugin::HOOK_CALL_FUNCTION) )
+        return true;
+
+    return false;
+}
+
 } // namespace zeek
@@ -5,6 +5,7 @@
 #include <optional>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "zeek/Type.h"
 #include "zeek/ZeekArgs.h"
@@ -66,6 +67,21 @@ public:
     // Returns the number of times this EventHandler has been called since startup.
     uint64_t CallCount() const;
 
+    /**
+     * Records which of the event's parameters any of its handler bodies
+     * read, as determined by script analysis after parsing.
+     */
+    void SetParamUsage(std::vector<bool> usage) { param_usage = std::move(usage); }
+
+    /**
+     * Returns false if no handler of the event reads the given parameter,
+     * nor does anything else get to see it, such as remote peers or
+     * plugins. Event generators can then pass a cheap placeholder of the
+     * right type instead of building a potentially expensive value.
+     * @param idx zero-based parameter index.
+     */
+    bool ParamUsed(int idx) const;
+
 private:
     void NewEvent(zeek::Args* vl); // Raise new_event() meta event.
 
@@ -81,6 +97,7 @@ private:
     std::shared_ptr<zeek::telemetry::Counter> call_count;
 
     std::unordered_set<std::string> auto_publish;
+    std::vector<bool> param_usage; // Empty if unknown.
 };
 
 // Encapsulates a ptr to an event handler to overload the boolean operator.
@@ -156,6 +156,7 @@ int truncate_http_URI;
 int dns_skip_all_auth;
 int dns_skip_all_addl;
 int dns_max_queries;
+int dns_batch_replies;
 
 double table_expire_interval;
 double table_expire_delay;
@@ -293,6 +294,7 @@ void init_net_var() {
     dns_skip_all_auth = id::find_val("dns_skip_all_auth")->AsBool();
     dns_skip_all_addl = id::find_val("dns_skip_all_addl")->AsBool();
     dns_max_queries = id::find_val("dns_max_queries")->AsCount();
+    dns_batch_replies = id::find_val("dns_batch_replies")->AsBool();
 
     orig_addr_anonymization = 0;
     if ( const auto& id = id::find("orig_addr_anonymization") )
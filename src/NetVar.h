@@ -58,6 +58,7 @@ extern int truncate_http_URI;
 extern int dns_skip_all_auth;
 extern int dns_skip_all_addl;
 extern int dns_max_queries;
+extern int dns_batch_replies;
 
 extern double table_expire_interval;
 extern double table_expire_delay;
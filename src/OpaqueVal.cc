@@ -673,7 +673,7 @@ bool SHA256Val::DoUnserializeData(BrokerDataView data) {
     return true;
 }
 
-EntropyVal::EntropyVal() : OpaqueVal(entropy_type) {}
+EntropyVal::EntropyVal(bool histogram_only) : OpaqueVal(entropy_type), state(histogram_only) {}
 
 bool EntropyVal::Feed(const void* data, size_t size) {
     state.add(data, size);
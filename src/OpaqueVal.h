@@ -353,7 +353,12 @@ private:
 
 class EntropyVal : public OpaqueVal {
 public:
-    EntropyVal();
+    /**
+     * Constructor.
+     * @param histogram_only if true, compute only the statistics derived
+     *        from the byte histogram, see RandTest.
+     */
+    explicit EntropyVal(bool histogram_only = false);
 
     bool Feed(const void* data, size_t size);
     bool Get(double* r_ent, double* r_chisq, double* r_mean, double* r_montepicalc, double* r_scc);
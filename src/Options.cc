@@ -199,6 +199,7 @@ static void print_analysis_help() {
     fprintf(stderr, "\n--optimize options when generating C++:\n");
     fprintf(stderr, "    allow-cond	allow standalone compilation of functions influenced by conditionals\n");
     fprintf(stderr, "    gen-C++	generate C++ script bodies\n");
+    fprintf(stderr, "    gen-C++-plugin	generate C++ script bodies packaged as a dynamic plugin\n");
     fprintf(stderr, "    gen-standalone-C++	generate \"standalone\" C++ script bodies\n");
     fprintf(stderr, "    help	print this list\n");
     fprintf(stderr, "    report-C++	report available C++ script bodies and exit\n");
@@ -230,6 +231,8 @@ static void set_analysis_option(const char* opt, Options& opts) {
         a_o.allow_cond = true;
     else if ( util::streq(opt, "gen-C++") )
         a_o.gen_CPP = true;
+    else if ( util::streq(opt, "gen-C++-plugin") )
+        a_o.gen_CPP_plugin = true;
     else if ( util::streq(opt, "gen-standalone-C++") )
         a_o.gen_standalone_CPP = true;
     else if ( util::streq(opt, "gen-ZAM-code") )
@@ -1,10 +1,166 @@
 #include "zeek/PrefixTable.h"
 
+#include <algorithm>
+
+#include "zeek/3rdparty/doctest.h"
 #include "zeek/Reporter.h"
 #include "zeek/Val.h"
 
 namespace zeek::detail {
 
+// Number of ranges beyond which we add the IPv4 directory to the index.
+static constexpr size_t MIN_RANGES_FOR_V4_DIR = 4096;
+
+// Minimum number of lookups since the last modification before we build
+// the range index, on top of one per node of the tree.
+static constexpr uint64_t MIN_LOOKUPS_FOR_INDEX = 64;
+
+PrefixRangeIndex::Key PrefixRangeIndex::ToKey(const uint8_t* bytes) {
+    Key k{0, 0};
+
+    for ( int i = 0; i < 8; ++i )
+        k.hi = (k.hi << 8) | bytes[i];
+
+    for ( int i = 8; i < 16; ++i )
+        k.lo = (k.lo << 8) | bytes[i];
+
+    return k;
+}
+
+void PrefixRangeIndex::AddRange(const Key& start, void* data) {
+    if ( ! starts.empty() && starts.back() == start ) {
+        // A more specific prefix starting at the same address, or the
+        // end of several prefixes at once.
+        values.back() = data;
+
+        if ( values.size() > 1 && values[values.size() - 2] == data ) {
+            starts.pop_back();
+            values.pop_back();
+        }
+
+        return;
+    }
+
+    if ( ! values.empty() && values.back() == data )
+        return;
+
+    starts.push_back(start);
+    values.push_back(data);
+}
+
+void PrefixRangeIndex::Build(const patricia_tree_t* tree) {
+    struct Entry {
+        Key start;
+        Key end;
+        int bitlen;
+        void* data;
+    };
+
+    std::vector<Entry> prefixes;
+    std::vector<patricia_node_t*> pending;
+
+    if ( tree->head )
+        pending.push_back(tree->head);
+
+    while ( ! pending.empty() ) {
+        auto n = pending.back();
+        pending.pop_back();
+
+        if ( n->l )
+            pending.push_back(n->l);
+        if ( n->r )
+            pending.push_back(n->r);
+
+        if ( ! n->prefix )
+            // Glue node.
+            continue;
+
+        int bits = n->prefix->bitlen;
+        uint64_t hi_mask = bits >= 64 ? ~uint64_t(0) : (bits == 0 ? 0 : ~uint64_t(0) << (64 - bits));
+        uint64_t lo_mask = bits <= 64 ? 0 : (bits >= 128 ? ~uint64_t(0) : ~uint64_t(0) << (128 - bits));
+
+        Key k = ToKey(reinterpret_cast<const uint8_t*>(&n->prefix->add.sin6));
+        Key start{k.hi & hi_mask, k.lo & lo_mask};
+        Key end{start.hi | ~hi_mask, start.lo | ~lo_mask};
+
+        prefixes.push_back({start, end, bits, n->data});
+    }
+
+    // Two prefixes either nest or don't overlap at all, so in this
+    // order every prefix is contained in all of those still open.
+    std::sort(prefixes.begin(), prefixes.end(), [](const Entry& a, const Entry& b) {
+        if ( a.start == b.start )
+            return a.bitlen < b.bitlen;
+        return a.start < b.start;
+    });
+
+    starts.clear();
+    values.clear();
+    v4_dir.clear();
+
+    AddRange({0, 0}, nullptr);
+
+    std::vector<const Entry*> open;
+
+    auto close_innermost = [&]() {
+        auto e = open.back();
+        open.pop_back();
+
+        if ( e->end.hi == ~uint64_t(0) && e->end.lo == ~uint64_t(0) )
+            return;
+
+        Key next{e->end.lo == ~uint64_t(0) ? e->end.hi + 1 : e->end.hi, e->end.lo + 1};
+        AddRange(next, open.empty() ? nullptr : open.back()->data);
+    };
+
+    for ( const auto& p : prefixes ) {
+        while ( ! open.empty() && open.back()->end < p.start )
+            close_innermost();
+
+        AddRange(p.start, p.data);
+        open.push_back(&p);
+    }
+
+    while ( ! open.empty() )
+        close_innermost();
+
+    if ( starts.size() < MIN_RANGES_FOR_V4_DIR )
+        return;
+
+    // IPv4 addresses live at ::ffff:0:0/96.
+    v4_dir.resize(1 << 16);
+
+    size_t j = Find({0, 0xffff00000000}, 0, starts.size());
+
+    for ( uint64_t i = 0; i < v4_dir.size(); ++i ) {
+        Key k{0, 0xffff00000000 | (i << 16)};
+
+        while ( j + 1 < starts.size() && ! (k < starts[j + 1]) )
+            ++j;
+
+        v4_dir[i] = static_cast<uint32_t>(j);
+    }
+}
+
+size_t PrefixRangeIndex::Find(const Key& k, size_t begin, size_t end) const {
+    auto it = std::upper_bound(starts.begin() + begin, starts.begin() + end, k);
+    return (it - starts.begin()) - 1;
+}
+
+void* PrefixRangeIndex::Lookup(const IPAddr& addr) const {
+    in6_addr a;
+    addr.CopyIPv6(&a);
+    Key k = ToKey(a.s6_addr);
+
+    if ( ! v4_dir.empty() && addr.GetFamily() == IPv4 ) {
+        size_t i = (k.lo >> 16) & 0xffff;
+        size_t end = i + 1 < v4_dir.size() ? v4_dir[i + 1] + 1 : starts.size();
+        return values[Find(k, v4_dir[i], end)];
+    }
+
+    return values[Find(k, 0, starts.size())];
+}
+
 prefix_t* PrefixTable::MakePrefix(const IPAddr& addr, int width) {
     prefix_t* prefix = (prefix_t*)util::safe_malloc(sizeof(prefix_t));
 
@@ -31,6 +187,8 @@ void* PrefixTable::Insert(const IPAddr& addr, int width, void* data) {
         return nullptr;
     }
 
+    InvalidateIndex();
+
     void* old = node->data;
 
     // If there is no data to be associated with addr, we take the
@@ -76,6 +234,17 @@ std::list<std::tuple<IPPrefix, void*>> PrefixTable::FindAll(const SubNetVal* val
 }
 
 void* PrefixTable::Lookup(const IPAddr& addr, int width, bool exact) const {
+    if ( ! exact && width == 128 ) {
+        if ( ! index_valid &&
+             ++lookups_since_change > static_cast<uint64_t>(tree->num_active_node) + MIN_LOOKUPS_FOR_INDEX ) {
+            index.Build(tree);
+            index_valid = true;
+        }
+
+        if ( index_valid )
+            return index.Lookup(addr);
+    }
+
     prefix_t* prefix = MakePrefix(addr, width);
     patricia_node_t* node = exact ? patricia_search_exact(tree, prefix) : patricia_search_best(tree, prefix);
 
@@ -112,6 +281,7 @@ void* PrefixTable::Remove(const IPAddr& addr, int width) {
 
     void* old = node->data;
     patricia_remove(tree, node);
+    InvalidateIndex();
 
     return old;
 }
@@ -167,4 +337,63 @@ void* PrefixTable::GetNext(iterator* i) {
     // Not reached.
 }
 
+TEST_SUITE_BEGIN("PrefixTable");
+
+TEST_CASE("range index matches the trie") {
+    PrefixTable t;
+    std::vector<IPPrefix> prefixes;
+    prefixes.reserve(10000);
+    uint32_t seed = 12345;
+
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return seed;
+    };
+
+    // Cluster the prefixes so that plenty of them nest.
+    for ( int i = 0; i < 5000; ++i ) {
+        uint32_t a = (next() & 0x0fff0000) | (next() & 0xffff);
+        uint32_t v6[4] = {0x20010db8, next() & 0xff, next(), next()};
+
+        IPPrefix p4(IPAddr(IPv4, &a, IPAddr::Host), 8 + next() % 25);
+        IPPrefix p6(IPAddr(IPv6, v6, IPAddr::Host), 32 + next() % 97);
+
+        t.Insert(p4.Prefix(), p4.LengthIPv6(), &prefixes.emplace_back(p4));
+        t.Insert(p6.Prefix(), p6.LengthIPv6(), &prefixes.emplace_back(p6));
+    }
+
+    // Drop a few again to exercise invalidation.
+    for ( int i = 0; i < 100; ++i ) {
+        const auto& p = prefixes[next() % prefixes.size()];
+        t.Remove(p.Prefix(), p.LengthIPv6());
+    }
+
+    auto longest = [&t](const IPAddr& a) -> void* {
+        void* best = nullptr;
+        int best_len = -1;
+
+        for ( const auto& [p, data] : t.FindAll(a, 128) )
+            if ( p.LengthIPv6() > best_len ) {
+                best = data;
+                best_len = p.LengthIPv6();
+            }
+
+        return best;
+    };
+
+    // Enough lookups for the table to switch over to the index.
+    for ( int i = 0; i < 100000; ++i ) {
+        uint32_t a = (next() & 0x0fff0000) | (next() & 0xffff);
+        uint32_t v6[4] = {0x20010db8, next() & 0xff, next(), next()};
+
+        IPAddr a4(IPv4, &a, IPAddr::Host);
+        IPAddr a6(IPv6, v6, IPAddr::Host);
+
+        CHECK(t.Lookup(a4, 128) == longest(a4));
+        CHECK(t.Lookup(a6, 128) == longest(a6));
+    }
+}
+
+TEST_SUITE_END();
+
 } // namespace zeek::detail
@@ -4,8 +4,10 @@ extern "C" {
 #include "zeek/3rdparty/patricia.h"
 }
 
+#include <cstdint>
 #include <list>
 #include <tuple>
+#include <vector>
 
 #include "zeek/IPAddr.h"
 
@@ -16,6 +18,49 @@ class SubNetVal;
 
 namespace detail {
 
+/**
+ * A read-only longest-prefix-match index over the contents of a patricia
+ * tree. The prefixes get flattened into a sorted array of disjoint address
+ * ranges, each mapping to the data of the longest prefix that covers it, so
+ * that a lookup is a binary search over contiguous memory rather than a
+ * pointer walk down the trie. For large indexes, a directory over the top 16
+ * bits of IPv4 addresses narrows that search further.
+ */
+class PrefixRangeIndex {
+public:
+    // Rebuilds the index from the tree's current contents.
+    void Build(const patricia_tree_t* tree);
+
+    // Returns the data of the longest prefix containing addr, or nil if
+    // there's none.
+    void* Lookup(const IPAddr& addr) const;
+
+    size_t NumRanges() const { return starts.size(); }
+
+private:
+    // A 128-bit address in host order, split into its two halves.
+    struct Key {
+        uint64_t hi;
+        uint64_t lo;
+
+        bool operator<(const Key& other) const { return hi < other.hi || (hi == other.hi && lo < other.lo); }
+        bool operator==(const Key& other) const { return hi == other.hi && lo == other.lo; }
+    };
+
+    static Key ToKey(const uint8_t* bytes);
+    void AddRange(const Key& start, void* data);
+    size_t Find(const Key& k, size_t begin, size_t end) const;
+
+    // Start addresses of the ranges, in ascending order; each range
+    // extends up to the start of the next.
+    std::vector<Key> starts;
+    std::vector<void*> values;
+
+    // If non-empty, v4_dir[i] is the index of the range that contains the
+    // first IPv4 address whose top 16 bits are i.
+    std::vector<uint32_t> v4_dir;
+};
+
 class PrefixTable {
 private:
     struct iterator {
@@ -54,7 +99,10 @@ public:
     void* Remove(const IPAddr& addr, int width);
     void* Remove(const Val* value);
 
-    void Clear() { Clear_Patricia(tree, delete_function); }
+    void Clear() {
+        Clear_Patricia(tree, delete_function);
+        InvalidateIndex();
+    }
 
     // Sets a function to call for each node when table is cleared/destroyed.
     void SetDeleteFunction(data_fn_t del_fn) { delete_function = del_fn; }
@@ -66,8 +114,21 @@ private:
     static prefix_t* MakePrefix(const IPAddr& addr, int width);
     static IPPrefix PrefixToIPPrefix(prefix_t* p);
 
+    void InvalidateIndex() {
+        index_valid = false;
+        lookups_since_change = 0;
+    }
+
     patricia_tree_t* tree;
     data_fn_t delete_function;
+
+    // Longest-prefix lookups of single addresses go to the range index
+    // once it has been built. We build it lazily, only after enough
+    // lookups have happened since the last modification to pay for the
+    // rebuild, so that bulk loads don't rebuild it per insertion.
+    mutable PrefixRangeIndex index;
+    mutable bool index_valid = false;
+    mutable uint64_t lookups_since_change = 0;
 };
 
 } // namespace detail
@@ -14,7 +14,15 @@
 
 #include "zeek/RandTest.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
 #include <cmath>
+#include <vector>
+
+#include "zeek/3rdparty/doctest.h"
 
 constexpr double log2of10 = 3.32192809488736234787;
 
@@ -22,11 +30,11 @@ constexpr double log2of10 = 3.32192809488736234787;
 static double rt_log2(double x) { return log2of10 * log10(x); }
 
 // RT_INCIRC = pow(pow(256.0, (double) (RT_MONTEN / 2)) - 1, 2.0);
-constexpr double RT_INCIRC = 281474943156225.0;
+constexpr uint64_t RT_INCIRC = 281474943156225;
 
 namespace zeek::detail {
 
-RandTest::RandTest() {
+RandTest::RandTest(bool arg_histogram_only) : histogram_only(arg_histogram_only) {
     totalc = 0;
     mp = 0;
     sccfirst = 1;
@@ -39,46 +47,190 @@ RandTest::RandTest() {
 }
 
 void RandTest::add(const void* buf, int bufl) {
+    if ( bufl <= 0 )
+        return;
+
     const unsigned char* bp = static_cast<const unsigned char*>(buf);
-    int oc;
-
-    while ( bufl-- > 0 ) {
-        oc = *bp++;
-        ccount[oc]++; /* Update counter for this bin */
-        totalc++;
-
-        /* Update inside / outside circle counts for Monte Carlo
-           computation of PI */
-        monte[mp++] = oc;      /* Save character for Monte Carlo */
-        if ( mp >= RT_MONTEN ) /* Calculate every RT_MONTEN character */
-        {
+
+    totalc += bufl;
+    count_bytes(bp, bufl);
+
+    if ( histogram_only )
+        return;
+
+    update_monte_carlo(bp, bufl);
+    update_serial_correlation(bp, bufl);
+}
+
+// Below this many bytes, counting straight into the bins is cheaper than
+// clearing and merging the interleaved ones.
+constexpr int RT_INTERLEAVE_MIN = 1024;
+
+void RandTest::count_bytes(const unsigned char* bp, int bufl) {
+    if ( bufl < RT_INTERLEAVE_MIN ) {
+        for ( int i = 0; i < bufl; i++ )
+            ccount[bp[i]]++;
+
+        return;
+    }
+
+    /* Runs of the same byte value would make each increment wait for
+       the previous one to the same bin. Spreading consecutive bytes
+       over four sets of bins lets the increments overlap. */
+    uint32_t bins[4][256] = {};
+    int i = 0;
+
+    for ( ; i + 4 <= bufl; i += 4 ) {
+        bins[0][bp[i]]++;
+        bins[1][bp[i + 1]]++;
+        bins[2][bp[i + 2]]++;
+        bins[3][bp[i + 3]]++;
+    }
+
+    for ( ; i < bufl; i++ )
+        bins[0][bp[i]]++;
+
+    for ( int b = 0; b < 256; b++ )
+        ccount[b] += int64_t(bins[0][b]) + bins[1][b] + bins[2][b] + bins[3][b];
+}
+
+/* Returns the co-ordinate given by RT_MONTEN / 2 bytes. It fits an
+   integer exactly, so computing with these matches the original floating
+   point computation. */
+template<typename T>
+static uint64_t rt_coord(const T* bytes) {
+    uint64_t v = 0;
+
+    for ( int mj = 0; mj < RT_MONTEN / 2; mj++ )
+        v = (v << 8) | bytes[mj];
+
+    return v;
+}
+
+/* Returns whether the point given by a group of RT_MONTEN bytes lies
+   inside the circle */
+template<typename T>
+static bool rt_in_circle(const T* group) {
+    uint64_t x = rt_coord(group);
+    uint64_t y = rt_coord(group + RT_MONTEN / 2);
+    return x * x + y * y <= RT_INCIRC;
+}
+
+void RandTest::update_monte_carlo(const unsigned char* bp, int bufl) {
+    /* Update inside / outside circle counts for Monte Carlo
+       computation of PI */
+    int i = 0;
+    int64_t groups = 0;
+    int64_t hits = 0;
+    const unsigned char* last = nullptr;
+
+    /* Complete a group left over from the previous call */
+    while ( mp > 0 && i < bufl ) {
+        monte[mp++] = bp[i++];
+
+        if ( mp >= RT_MONTEN ) {
             mp = 0;
-            mcount++;
-            montex = 0;
-            montey = 0;
-            for ( int mj = 0; mj < RT_MONTEN / 2; mj++ ) {
-                montex = (montex * 256.0) + monte[mj];
-                montey = (montey * 256.0) + monte[(RT_MONTEN / 2) + mj];
-            }
-            if ( montex * montex + montey * montey <= RT_INCIRC ) {
-                inmont++;
-            }
+            groups++;
+            hits += rt_in_circle(monte);
+            montex = rt_coord(monte);
+            montey = rt_coord(monte + RT_MONTEN / 2);
         }
+    }
 
-        /* Update calculation of serial correlation coefficient */
-        if ( sccfirst ) {
-            sccfirst = 0;
-            sccu0 = oc;
-        }
-        else {
-            scct1 = scct1 + scclast * oc;
+    /* Take full groups straight from the buffer */
+    for ( ; i + RT_MONTEN <= bufl; i += RT_MONTEN ) {
+        groups++;
+        hits += rt_in_circle(bp + i);
+        last = bp + i;
+    }
+
+    /* Save the remainder for the next call */
+    for ( ; i < bufl; i++ )
+        monte[mp++] = bp[i];
+
+    mcount += groups;
+    inmont += hits;
+
+    if ( last ) {
+        montex = rt_coord(last);
+        montey = rt_coord(last + RT_MONTEN / 2);
+    }
+}
+
+#if defined(__SSE2__)
+static uint64_t rt_sum_epi32(__m128i v) {
+    uint32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+    return uint64_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+}
+
+static uint64_t rt_sum_epi64(__m128i v) {
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+    return lanes[0] + lanes[1];
+}
+#endif
+
+void RandTest::update_serial_correlation(const unsigned char* bp, int bufl) {
+    /* The sums stay exact in integers, so accumulating them per call
+       gives the same result as the original per-byte doubles. */
+    uint64_t t1 = 0;
+    uint64_t t2 = bp[0];
+    uint64_t t3 = bp[0] * bp[0];
+
+    if ( sccfirst ) {
+        sccfirst = 0;
+        sccu0 = bp[0];
+    }
+    else
+        scct1 = scct1 + scclast * bp[0];
+
+    int i = 1;
+
+#if defined(__SSE2__)
+    /* Sixteen bytes at a time, pairing each with its predecessor. Each
+       32-bit lane grows by at most 4 * 255 * 255 per step, so the lanes
+       get flushed before they could overflow. */
+    const __m128i zero = _mm_setzero_si128();
+
+    while ( i + 16 <= bufl ) {
+        int end = std::min(bufl - 15, i + 16 * 8192);
+        __m128i acc1 = zero;
+        __m128i acc2 = zero;
+        __m128i acc3 = zero;
+
+        for ( ; i < end; i += 16 ) {
+            __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bp + i));
+            __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bp + i - 1));
+            __m128i cur_lo = _mm_unpacklo_epi8(cur, zero);
+            __m128i cur_hi = _mm_unpackhi_epi8(cur, zero);
+            __m128i prev_lo = _mm_unpacklo_epi8(prev, zero);
+            __m128i prev_hi = _mm_unpackhi_epi8(prev, zero);
+
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(prev_lo, cur_lo));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(prev_hi, cur_hi));
+            acc2 = _mm_add_epi64(acc2, _mm_sad_epu8(cur, zero));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(cur_lo, cur_lo));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(cur_hi, cur_hi));
         }
 
-        scct2 = scct2 + oc;
-        scct3 = scct3 + (oc * oc);
-        scclast = oc;
-        oc <<= 1;
+        t1 += rt_sum_epi32(acc1);
+        t2 += rt_sum_epi64(acc2);
+        t3 += rt_sum_epi32(acc3);
     }
+#endif
+
+    for ( ; i < bufl; i++ ) {
+        uint64_t oc = bp[i];
+        t1 += bp[i - 1] * oc;
+        t2 += oc;
+        t3 += oc * oc;
+    }
+
+    scct1 = scct1 + t1;
+    scct2 = scct2 + t2;
+    scct3 = scct3 + t3;
+    scclast = bp[bufl - 1];
 }
 
 void RandTest::end(double* r_ent, double* r_chisq, double* r_mean, double* r_montepicalc, double* r_scc) {
@@ -122,6 +274,9 @@ void RandTest::end(double* r_ent, double* r_chisq, double* r_mean, double* r_mon
        within the circle */
     montepi = mcount == 0 ? 0 : 4.0 * (((double)inmont) / mcount);
 
+    if ( histogram_only )
+        montepi = scc = 0.0;
+
     /* Return results through arguments */
     *r_ent = ent;
     *r_chisq = chisq;
@@ -130,4 +285,61 @@ void RandTest::end(double* r_ent, double* r_chisq, double* r_mean, double* r_mon
     *r_scc = scc;
 }
 
+TEST_SUITE_BEGIN("RandTest");
+
+struct RandTestResult {
+    double ent, chisq, mean, montepi, scc;
+};
+
+static RandTestResult rt_feed(const std::vector<unsigned char>& data, int chunk, bool histogram_only = false) {
+    RandTest rt(histogram_only);
+    RandTestResult r;
+
+    for ( size_t i = 0; i < data.size(); i += chunk )
+        rt.add(data.data() + i, std::min<int>(chunk, data.size() - i));
+
+    rt.end(&r.ent, &r.chisq, &r.mean, &r.montepi, &r.scc);
+    return r;
+}
+
+TEST_CASE("uniform bytes") {
+    std::vector<unsigned char> data(256 * 16);
+    for ( size_t i = 0; i < data.size(); i++ )
+        data[i] = i % 256;
+
+    auto r = rt_feed(data, data.size());
+    CHECK(r.ent == doctest::Approx(8.0));
+    CHECK(r.chisq == doctest::Approx(0.0));
+    CHECK(r.mean == doctest::Approx(127.5));
+}
+
+TEST_CASE("chunking does not change results") {
+    std::vector<unsigned char> data(100000);
+    uint32_t x = 12345;
+    for ( auto& b : data ) {
+        x = x * 1103515245 + 12345;
+        b = x >> 24;
+    }
+
+    auto whole = rt_feed(data, data.size());
+
+    for ( int chunk : {1, 5, 7, 1023, 1024, 4099} ) {
+        auto r = rt_feed(data, chunk);
+        CHECK(r.ent == whole.ent);
+        CHECK(r.chisq == whole.chisq);
+        CHECK(r.mean == whole.mean);
+        CHECK(r.montepi == whole.montepi);
+        CHECK(r.scc == whole.scc);
+    }
+
+    auto hist = rt_feed(data, 1000, true);
+    CHECK(hist.ent == whole.ent);
+    CHECK(hist.chisq == whole.chisq);
+    CHECK(hist.mean == whole.mean);
+    CHECK(hist.montepi == 0.0);
+    CHECK(hist.scc == 0.0);
+}
+
+TEST_SUITE_END();
+
 } // namespace zeek::detail
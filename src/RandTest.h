@@ -18,13 +18,26 @@ namespace detail {
 
 class RandTest {
 public:
-    RandTest();
+    /**
+     * Constructor.
+     * @param histogram_only if true, only the byte histogram gets
+     *        maintained. That's all that entropy, chi-square and mean need,
+     *        while the Monte Carlo value for pi and the serial correlation
+     *        coefficient are then reported as zero.
+     */
+    explicit RandTest(bool histogram_only = false);
     void add(const void* buf, int bufl);
     void end(double* r_ent, double* r_chisq, double* r_mean, double* r_montepicalc, double* r_scc);
 
 private:
     friend class zeek::EntropyVal;
 
+    void count_bytes(const unsigned char* bp, int bufl);
+    void update_monte_carlo(const unsigned char* bp, int bufl);
+    void update_serial_correlation(const unsigned char* bp, int bufl);
+
+    bool histogram_only;
+
     int64_t ccount[256]; /* Bins to count occurrences of values */
     int64_t totalc;      /* Total bytes counted */
     int mp;
@@ -49,6 +49,13 @@ uint32_t SerializationFormat::EndWrite(char** data) {
     return rval;
 }
 
+uint32_t SerializationFormat::EndWrite(std::string* data) {
+    uint32_t rval = output_pos;
+    data->assign(output, output_pos);
+    output_pos = 0;
+    return rval;
+}
+
 bool SerializationFormat::ReadData(void* b, size_t count) {
     if ( input_pos + count > input_len ) {
         reporter->Error("data underflow during read in binary format");
@@ -59,6 +59,15 @@ public:
      */
     virtual uint32_t EndWrite(char** data);
 
+    /**
+     * Retrieves a copy of the serialized data. Unlike EndWrite(char**),
+     * this keeps the internal buffer so that the next StartWrite() can
+     * reuse it instead of allocating a new one.
+     * @param data The string to assign the serialized data to.
+     * @return The number of bytes assigned to \a data.
+     */
+    uint32_t EndWrite(std::string* data);
+
     virtual bool Write(int v, const char* tag) = 0;
     virtual bool Write(uint16_t v, const char* tag) = 0;
     virtual bool Write(uint32_t v, const char* tag) = 0;
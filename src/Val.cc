@@ -738,6 +738,9 @@ StringVal::StringVal(int length, const char* s)
 
 StringVal::StringVal(std::string_view s) : StringVal(s.length(), s.data()) {}
 
+StringVal::StringVal(detail::StringBufferPtr buffer, int length, const u_char* s)
+    : StringVal(new String(std::move(buffer), s, length)) {}
+
 StringVal::~StringVal() { delete string_val; }
 
 ValPtr StringVal::SizeVal() const { return val_mgr->Count(string_val->Len()); }
@@ -3927,6 +3930,33 @@ ValManager::ValManager() {
             arr[j] = make_intrusive<PortVal>(PortVal::Mask(j, port_type));
     }
 #endif
+
+    // The table is fixed up front rather than filled on demand, as the
+    // strings passed in come straight from traffic.
+    static constexpr const char* well_known_strings[] = {
+        // HTTP request methods and versions.
+        "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "PROPFIND", "PROPPATCH",
+        "MKCOL", "COPY", "MOVE", "LOCK", "UNLOCK", "0.9", "1.0", "1.1", "2.0", "<empty>",
+        // SMTP commands.
+        "EHLO", "HELO", "MAIL", "RCPT", "DATA", "QUIT", "RSET", "VRFY", "EXPN", "HELP", "NOOP", "STARTTLS",
+        "X-ANONYMOUSTLS", "SEND", "SOML", "SAML", "TURN", "BDAT", "ETRN", "AUTH", "."};
+
+    for ( const char* str : well_known_strings ) {
+        auto sv = make_intrusive<StringVal>(str);
+        std::string_view key{reinterpret_cast<const char*>(sv->Bytes()), static_cast<size_t>(sv->Len())};
+        interned_strings.emplace(key, std::move(sv));
+    }
+}
+
+StringValPtr ValManager::InternedString(std::string_view s) {
+    if ( s.empty() )
+        return empty_string;
+
+    auto it = interned_strings.find(s);
+    if ( it != interned_strings.end() )
+        return it->second;
+
+    return make_intrusive<StringVal>(s);
 }
 
 const PortValPtr& ValManager::Port(uint32_t port_num, TransportProto port_type) {
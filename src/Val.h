@@ -51,6 +51,8 @@ class Frame;
 class PrefixTable;
 class HashKey;
 class TablePatternMatcher;
+class StringBuffer;
+using StringBufferPtr = IntrusivePtr<StringBuffer>;
 
 struct DFA_State_Cache_Stats;
 
@@ -329,6 +331,12 @@ public:
 
     inline const StringValPtr& EmptyString() const { return empty_string; }
 
+    // Returns a shared StringVal for strings that analyzers emit over and
+    // over (HTTP methods and versions, SMTP commands).  The returned value
+    // must not be modified.  Strings other than these well-known ones
+    // yield a fresh StringVal.
+    StringValPtr InternedString(std::string_view s);
+
     // Port number given in host order.
     const PortValPtr& Port(uint32_t port_num, TransportProto port_type);
 
@@ -345,6 +353,10 @@ private:
     std::array<ValPtr, PREALLOCATED_COUNTS> counts;
     std::array<ValPtr, PREALLOCATED_INTS> ints;
     StringValPtr empty_string;
+
+    // Populated once in the constructor.  Keys point into the
+    // corresponding StringVal's bytes.
+    std::unordered_map<std::string_view, StringValPtr> interned_strings;
     ValPtr b_true;
     ValPtr b_false;
 };
@@ -541,6 +553,13 @@ public:
     explicit StringVal(String* s);
     StringVal(std::string_view s);
     StringVal(int length, const char* s);
+
+    // Borrows the given region of a shared buffer rather than copying
+    // it; see the corresponding String constructor.  Meant for analyzers
+    // whose buffers are reference-counted, to avoid copying lines or
+    // headers that scripts typically only inspect.
+    StringVal(detail::StringBufferPtr buffer, int length, const u_char* s);
+
     ~StringVal() override;
 
     ValPtr SizeVal() const override;
@@ -35,6 +35,18 @@ String::String(bool arg_final_NUL, byte_vec str, int arg_n) {
     n = arg_n;
     final_NUL = arg_final_NUL;
     use_free_to_delete = false;
+    borrowed_from = nullptr;
+}
+
+String::String(detail::StringBufferPtr buffer, const u_char* str, int arg_n) : String() {
+    if ( buffer && buffer->Contains(str, arg_n + 1) && str[arg_n] == '\0' ) {
+        b = const_cast<u_char*>(str);
+        n = arg_n;
+        final_NUL = true;
+        borrowed_from = buffer.release();
+    }
+    else
+        Set(str, arg_n);
 }
 
 String::String(const u_char* str, int arg_n, bool add_NUL) : String() { Set(str, arg_n, add_NUL); }
@@ -48,10 +60,15 @@ String::String() {
     n = 0;
     final_NUL = false;
     use_free_to_delete = false;
+    borrowed_from = nullptr;
 }
 
 void String::Reset() {
-    if ( use_free_to_delete )
+    if ( borrowed_from )
+        Unref(borrowed_from);
+    else if ( b == small )
+        ;
+    else if ( use_free_to_delete )
         free(b);
     else
         delete[] b;
@@ -60,6 +77,23 @@ void String::Reset() {
     n = 0;
     final_NUL = false;
     use_free_to_delete = false;
+    borrowed_from = nullptr;
+}
+
+void String::Materialize() {
+    if ( ! borrowed_from )
+        return;
+
+    auto copy = Alloc(n + 1);
+    memcpy(copy, b, n);
+    copy[n] = '\0';
+
+    Unref(borrowed_from);
+    borrowed_from = nullptr;
+
+    b = copy;
+    final_NUL = true;
+    use_free_to_delete = false;
 }
 
 const String& String::operator=(const String& bs) {
@@ -68,7 +102,7 @@ const String& String::operator=(const String& bs) {
 
     Reset();
     n = bs.n;
-    b = new u_char[n + 1];
+    b = Alloc(n + 1);
 
     memcpy(b, bs.b, n);
     b[n] = '\0';
@@ -110,7 +144,7 @@ void String::Set(const u_char* str, int len, bool add_NUL) {
     Reset();
 
     n = len;
-    b = new u_char[add_NUL ? n + 1 : n];
+    b = Alloc(add_NUL ? n + 1 : n);
     memcpy(b, str, n);
     final_NUL = add_NUL;
 
@@ -125,7 +159,7 @@ void String::Set(std::string_view str) {
 
     if ( ! str.empty() ) {
         n = str.size();
-        b = new u_char[n + 1];
+        b = Alloc(n + 1);
         memcpy(b, str.data(), n);
         b[n] = 0;
         final_NUL = true;
@@ -245,6 +279,8 @@ std::istream& String::Read(std::istream& is, int format) {
 }
 
 void String::ToUpper() {
+    Materialize();
+
     for ( int i = 0; i < n; ++i )
         if ( islower(b[i]) )
             b[i] = toupper(b[i]);
@@ -486,6 +522,54 @@ TEST_CASE("construction") {
     CHECK_EQ(s10.Bytes(), text5);
 }
 
+TEST_CASE("small strings") {
+    zeek::String s1{"GET"};
+    zeek::String s2{s1};
+    CHECK_NE(s1.Bytes(), s2.Bytes());
+    CHECK_EQ(s2, "GET");
+
+    s2.Set("a much longer string that doesn't fit inline");
+    CHECK_EQ(s2, "a much longer string that doesn't fit inline");
+    s2 = s1;
+    CHECK_EQ(s2, "GET");
+    CHECK_EQ(std::string(s2.CheckString()), "GET");
+
+    zeek::String s3{reinterpret_cast<const u_char*>("0123456789abcdef"), 16, true};
+    CHECK_EQ(s3.Len(), 16);
+    CHECK_EQ(s3, "0123456789abcdef");
+}
+
+TEST_CASE("borrowing") {
+    auto buffer = zeek::make_intrusive<zeek::detail::StringBuffer>(16);
+    memcpy(buffer->Data(), "abc\0defg", 8);
+    CHECK_FALSE(buffer->Shared());
+
+    auto* s1 = new zeek::String(buffer, buffer->Data(), 3);
+    CHECK(s1->IsBorrowed());
+    CHECK(buffer->Shared());
+    CHECK_EQ(s1->Bytes(), buffer->Data());
+    CHECK_EQ(std::string(s1->CheckString()), "abc");
+
+    // Not NUL-terminated within the buffer, so gets copied.
+    zeek::String s2{buffer, buffer->Data() + 4, 3};
+    CHECK_FALSE(s2.IsBorrowed());
+    CHECK_EQ(s2, "def");
+
+    s1->ToUpper();
+    CHECK_FALSE(s1->IsBorrowed());
+    CHECK_EQ(*s1, "ABC");
+    CHECK_EQ(std::string(reinterpret_cast<const char*>(buffer->Data())), "abc");
+    CHECK_FALSE(buffer->Shared());
+
+    zeek::String s3{buffer, buffer->Data(), 3};
+    CHECK(buffer->Shared());
+    s3.Materialize();
+    CHECK_FALSE(buffer->Shared());
+    CHECK_EQ(s3, "abc");
+
+    delete s1;
+}
+
 TEST_CASE("set/assignment/comparison") {
     zeek::String s{"abc"};
     CHECK_EQ(s, "abc");
@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include "zeek/IntrusivePtr.h"
+
 namespace zeek {
 
 // Forward declaration, for helper functions that convert (sub)string vectors
@@ -18,6 +20,50 @@ class VectorVal;
 
 using byte_vec = u_char*;
 
+namespace detail {
+
+/**
+ * A reference-counted byte buffer that Strings can borrow from rather than
+ * copying its contents. The owner of the buffer must not modify it while
+ * Shared() returns true, but instead switch to a fresh buffer.
+ */
+class StringBuffer {
+public:
+    explicit StringBuffer(int arg_size) : data(new u_char[arg_size]), size(arg_size) {}
+    ~StringBuffer() { delete[] data; }
+
+    StringBuffer(const StringBuffer&) = delete;
+    StringBuffer& operator=(const StringBuffer&) = delete;
+
+    u_char* Data() const { return data; }
+    int Size() const { return size; }
+
+    /**
+     * Returns true if any String still references the buffer.
+     */
+    bool Shared() const { return ref_cnt > 1; }
+
+    /**
+     * Returns true if the given region lies entirely within the buffer.
+     */
+    bool Contains(const u_char* p, int len) const { return p >= data && len >= 0 && p + len <= data + size; }
+
+private:
+    friend void Ref(StringBuffer* b) { ++b->ref_cnt; }
+    friend void Unref(StringBuffer* b) {
+        if ( b && --b->ref_cnt == 0 )
+            delete b;
+    }
+
+    u_char* data;
+    int size;
+    int ref_cnt = 1;
+};
+
+using StringBufferPtr = IntrusivePtr<StringBuffer>;
+
+} // namespace detail
+
 /**
  * A container type for holding blocks of byte data. This can be used for
  * character strings, but is not limited to that alone. This class provides
@@ -47,6 +93,13 @@ public:
     // Constructor that takes ownership of the vector passed in.
     String(bool arg_final_NUL, byte_vec str, int arg_n);
 
+    // Constructor that borrows the given region of a shared buffer
+    // rather than copying it.  The buffer is kept alive for as long
+    // as the string references it.  If the region isn't followed by
+    // a NUL within the buffer, the data is copied instead, as strings
+    // are expected to be NUL-terminated.
+    String(detail::StringBufferPtr buffer, const u_char* str, int arg_n);
+
     String();
     ~String() { Reset(); }
 
@@ -56,9 +109,19 @@ public:
     bool operator==(std::string_view s) const;
     bool operator!=(std::string_view s) const;
 
+    // Note: for borrowed strings, the returned bytes belong to a shared
+    // buffer and must not be modified without first calling Materialize().
     byte_vec Bytes() const { return b; }
     int Len() const { return n; }
 
+    // Returns true if the string references a shared buffer rather than
+    // owning its bytes.
+    bool IsBorrowed() const { return borrowed_from != nullptr; }
+
+    // Makes the string own a private copy of its bytes, releasing
+    // any shared buffer it was borrowing from.
+    void Materialize();
+
     // Releases the string's current contents, if any, and
     // adopts the byte vector of given length.  The string will
     // manage the memory occupied by the string afterwards.
@@ -159,10 +222,24 @@ public:
 protected:
     void Reset();
 
+    // Returns storage for a copy of the given size, using the inline
+    // buffer if it fits.
+    byte_vec Alloc(int size) { return size <= SMALL_STRING_SIZE ? small : new u_char[size]; }
+
+    // Strings up to this size (including the final NUL) are stored inline
+    // rather than on the heap. The vast majority of strings seen in traffic
+    // (methods, status codes, header names, TLDs) fit.
+    static constexpr int SMALL_STRING_SIZE = 16;
+
     byte_vec b;
     int n;
     bool final_NUL;          // whether we have added a final NUL
     bool use_free_to_delete; // free() vs. operator delete
+
+    // If non-nil, the buffer that b points into; we don't own b.
+    detail::StringBuffer* borrowed_from;
+
+    u_char small[SMALL_STRING_SIZE];
 };
 
 // A comparison class that sorts pointers to String's according to
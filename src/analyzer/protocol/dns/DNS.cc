@@ -21,6 +21,33 @@ namespace zeek::analyzer::dns {
 
 namespace detail {
 
+// Returns true if ParseAnswer() collects records of the given type for
+// dns_replies when batching them, rather than raising their own event.
+static bool batched_type(RR_Type t) {
+    switch ( t ) {
+        case TYPE_SOA:
+        case TYPE_WKS:
+        case TYPE_HINFO:
+        case TYPE_CAA:
+        case TYPE_NBS:
+        case TYPE_EDNS:
+        case TYPE_TSIG:
+        case TYPE_RRSIG:
+        case TYPE_DNSKEY:
+        case TYPE_NSEC:
+        case TYPE_NSEC3:
+        case TYPE_NSEC3PARAM:
+        case TYPE_DS:
+        case TYPE_BINDS:
+        case TYPE_SSHFP:
+        case TYPE_LOC:
+        case TYPE_SVCB:
+        case TYPE_HTTPS: return false;
+
+        default: return true;
+    }
+}
+
 DNS_Interpreter::DNS_Interpreter(analyzer::Analyzer* arg_analyzer) {
     analyzer = arg_analyzer;
     first_message = true;
@@ -45,9 +72,11 @@ void DNS_Interpreter::ParseMessage(const u_char* data, int len, int is_query) {
 
     first_message = false;
 
+    msg.batch_replies = zeek::detail::dns_batch_replies && dns_replies;
+
     if ( dns_message )
-        analyzer->EnqueueConnEvent(dns_message, analyzer->ConnVal(), val_mgr->Bool(is_query), msg.BuildHdrVal(),
-                                   val_mgr->Count(len));
+        analyzer->EnqueueConnEvent(dns_message, analyzer->ConnVal(), val_mgr->Bool(is_query),
+                                   msg.BuildHdrVal(dns_message, 2), val_mgr->Count(len));
 
     // There is a great deal of non-DNS traffic that runs on port 53.
     // This should weed out most of it.
@@ -114,8 +143,16 @@ void DNS_Interpreter::ParseMessage(const u_char* data, int len, int is_query) {
 }
 
 void DNS_Interpreter::EndMessage(detail::DNS_MsgInfo* msg) {
+    SendReplies(msg);
+
     if ( dns_end )
-        analyzer->EnqueueConnEvent(dns_end, analyzer->ConnVal(), msg->BuildHdrVal());
+        analyzer->EnqueueConnEvent(dns_end, analyzer->ConnVal(), msg->BuildHdrVal(dns_end, 1));
+}
+
+void DNS_Interpreter::SendReplies(detail::DNS_MsgInfo* msg) {
+    if ( msg->rrs )
+        analyzer->EnqueueConnEvent(dns_replies, analyzer->ConnVal(), msg->BuildHdrVal(dns_replies, 1),
+                                   std::move(msg->rrs));
 }
 
 bool DNS_Interpreter::ParseQuestions(detail::DNS_MsgInfo* msg, const u_char*& data, int& len, const u_char* msg_start) {
@@ -214,6 +251,11 @@ bool DNS_Interpreter::ParseAnswer(detail::DNS_MsgInfo* msg, const u_char*& data,
         return false;
     }
 
+    // A record keeping its individual event first flushes the batched
+    // ones before it, so that handlers see all records in message order.
+    if ( msg->rrs && ! batched_type(msg->atype) )
+        SendReplies(msg);
+
     bool status;
     switch ( msg->atype ) {
         case detail::TYPE_A: status = ParseRR_A(msg, data, len, rdlength); break;
@@ -281,10 +323,11 @@ bool DNS_Interpreter::ParseAnswer(detail::DNS_MsgInfo* msg, const u_char*& data,
         case detail::TYPE_HTTPS: status = ParseRR_SVCB(msg, data, len, rdlength, msg_start, TYPE_HTTPS); break;
 
         default:
-
-            if ( dns_unknown_reply && ! msg->skip_event )
-                analyzer->EnqueueConnEvent(dns_unknown_reply, analyzer->ConnVal(), msg->BuildHdrVal(),
-                                           msg->BuildAnswerVal());
+            // A batched record has nothing beyond its general part.
+            if ( ! msg->AddRR() && dns_unknown_reply && ! msg->skip_event )
+                analyzer->EnqueueConnEvent(dns_unknown_reply, analyzer->ConnVal(),
+                                           msg->BuildHdrVal(dns_unknown_reply, 1),
+                                           msg->BuildAnswerVal(dns_unknown_reply, 2));
 
             analyzer->Weird("DNS_RR_unknown_type", util::fmt("%d", msg->atype));
             data += rdlength;
@@ -469,8 +512,12 @@ bool DNS_Interpreter::ParseRR_Name(detail::DNS_MsgInfo* msg, const u_char*& data
         default: analyzer->Conn()->Internal("DNS_RR_bad_name"); reply_event = nullptr;
     }
 
-    if ( reply_event && ! msg->skip_event )
-        analyzer->EnqueueConnEvent(reply_event, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
+    if ( auto rr = msg->AddRR() )
+        rr->Assign(2, new String(name, name_end - name, true));
+
+    else if ( reply_event && ! msg->skip_event )
+        analyzer->EnqueueConnEvent(reply_event, analyzer->ConnVal(), msg->BuildHdrVal(reply_event, 1),
+                                   msg->BuildAnswerVal(reply_event, 2),
                                    make_intrusive<StringVal>(new String(name, name_end - name, true)));
 
     return true;
@@ -517,8 +564,8 @@ bool DNS_Interpreter::ParseRR_SOA(detail::DNS_MsgInfo* msg, const u_char*& data,
         r->AssignInterval(5, double(expire));
         r->AssignInterval(6, double(minimum));
 
-        analyzer->EnqueueConnEvent(dns_SOA_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   std::move(r));
+        analyzer->EnqueueConnEvent(dns_SOA_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_SOA_reply, 1),
+                                   msg->BuildAnswerVal(dns_SOA_reply, 2), std::move(r));
     }
 
     return true;
@@ -540,8 +587,14 @@ bool DNS_Interpreter::ParseRR_MX(detail::DNS_MsgInfo* msg, const u_char*& data,
     if ( data - data_start != rdlength )
         analyzer->Weird("DNS_RR_length_mismatch");
 
-    if ( dns_MX_reply && ! msg->skip_event )
-        analyzer->EnqueueConnEvent(dns_MX_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
+    if ( auto rr = msg->AddRR() ) {
+        rr->Assign(2, new String(name, name_end - name, true));
+        rr->Assign(4, preference);
+    }
+
+    else if ( dns_MX_reply && ! msg->skip_event )
+        analyzer->EnqueueConnEvent(dns_MX_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_MX_reply, 1),
+                                   msg->BuildAnswerVal(dns_MX_reply, 2),
                                    make_intrusive<StringVal>(new String(name, name_end - name, true)),
                                    val_mgr->Count(preference));
 
@@ -573,8 +626,16 @@ bool DNS_Interpreter::ParseRR_SRV(detail::DNS_MsgInfo* msg, const u_char*& data,
     if ( data - data_start != rdlength )
         analyzer->Weird("DNS_RR_length_mismatch");
 
-    if ( dns_SRV_reply && ! msg->skip_event )
-        analyzer->EnqueueConnEvent(dns_SRV_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
+    if ( auto rr = msg->AddRR() ) {
+        rr->Assign(2, new String(name, name_end - name, true));
+        rr->Assign(4, priority);
+        rr->Assign(5, weight);
+        rr->Assign(6, port);
+    }
+
+    else if ( dns_SRV_reply && ! msg->skip_event )
+        analyzer->EnqueueConnEvent(dns_SRV_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_SRV_reply, 1),
+                                   msg->BuildAnswerVal(dns_SRV_reply, 2),
                                    make_intrusive<StringVal>(new String(name, name_end - name, true)),
                                    val_mgr->Count(priority), val_mgr->Count(weight), val_mgr->Count(port));
 
@@ -584,7 +645,8 @@ bool DNS_Interpreter::ParseRR_SRV(detail::DNS_MsgInfo* msg, const u_char*& data,
 bool DNS_Interpreter::ParseRR_EDNS(detail::DNS_MsgInfo* msg, const u_char*& data, int& len, int rdlength,
                                    const u_char* msg_start) {
     if ( dns_EDNS_addl && ! msg->skip_event )
-        analyzer->EnqueueConnEvent(dns_EDNS_addl, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildEDNS_Val());
+        analyzer->EnqueueConnEvent(dns_EDNS_addl, analyzer->ConnVal(), msg->BuildHdrVal(dns_EDNS_addl, 1),
+                                   msg->BuildEDNS_Val());
 
     // parse EDNS options. length has to be at least 4 to parse out the option
     // code and length.
@@ -689,7 +751,7 @@ bool DNS_Interpreter::ParseRR_EDNS(detail::DNS_MsgInfo* msg, const u_char*& data
                     break;
                 }
 
-                analyzer->EnqueueConnEvent(dns_EDNS_ecs, analyzer->ConnVal(), msg->BuildHdrVal(),
+                analyzer->EnqueueConnEvent(dns_EDNS_ecs, analyzer->ConnVal(), msg->BuildHdrVal(dns_EDNS_ecs, 1),
                                            msg->BuildEDNS_ECS_Val(&opt));
                 data += option_len;
                 break;
@@ -713,7 +775,8 @@ bool DNS_Interpreter::ParseRR_EDNS(detail::DNS_MsgInfo* msg, const u_char*& data
                         analyzer->Weird("EDNS_TCP_Keepalive_In_UDP");
                     }
 
-                    analyzer->EnqueueConnEvent(dns_EDNS_tcp_keepalive, analyzer->ConnVal(), msg->BuildHdrVal(),
+                    analyzer->EnqueueConnEvent(dns_EDNS_tcp_keepalive, analyzer->ConnVal(),
+                                               msg->BuildHdrVal(dns_EDNS_tcp_keepalive, 1),
                                                msg->BuildEDNS_TCP_KA_Val(&edns_tcp_keepalive));
                 }
                 else {
@@ -746,7 +809,7 @@ bool DNS_Interpreter::ParseRR_EDNS(detail::DNS_MsgInfo* msg, const u_char*& data
                     cookie.server_cookie = ExtractStream(data, server_cookie_len, server_cookie_len);
                 }
 
-                analyzer->EnqueueConnEvent(dns_EDNS_cookie, analyzer->ConnVal(), msg->BuildHdrVal(),
+                analyzer->EnqueueConnEvent(dns_EDNS_cookie, analyzer->ConnVal(), msg->BuildHdrVal(dns_EDNS_cookie, 1),
                                            msg->BuildEDNS_COOKIE_Val(&cookie));
 
                 break;
@@ -818,7 +881,8 @@ bool DNS_Interpreter::ParseRR_TSIG(detail::DNS_MsgInfo* msg, const u_char*& data
         tsig.orig_id = orig_id;
         tsig.rr_error = rr_error;
 
-        analyzer->EnqueueConnEvent(dns_TSIG_addl, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildTSIG_Val(&tsig));
+        analyzer->EnqueueConnEvent(dns_TSIG_addl, analyzer->ConnVal(), msg->BuildHdrVal(dns_TSIG_addl, 1),
+                                   msg->BuildTSIG_Val(&tsig));
     }
 
     return true;
@@ -892,8 +956,8 @@ bool DNS_Interpreter::ParseRR_RRSIG(detail::DNS_MsgInfo* msg, const u_char*& dat
         rrsig.signer_name = new String(name, name_end - name, true);
         rrsig.signature = sign;
 
-        analyzer->EnqueueConnEvent(dns_RRSIG, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildRRSIG_Val(&rrsig));
+        analyzer->EnqueueConnEvent(dns_RRSIG, analyzer->ConnVal(), msg->BuildHdrVal(dns_RRSIG, 1),
+                                   msg->BuildAnswerVal(dns_RRSIG, 2), msg->BuildRRSIG_Val(&rrsig));
     }
 
     return true;
@@ -968,8 +1032,8 @@ bool DNS_Interpreter::ParseRR_DNSKEY(detail::DNS_MsgInfo* msg, const u_char*& da
         dnskey.dprotocol = dprotocol;
         dnskey.public_key = key;
 
-        analyzer->EnqueueConnEvent(dns_DNSKEY, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildDNSKEY_Val(&dnskey));
+        analyzer->EnqueueConnEvent(dns_DNSKEY, analyzer->ConnVal(), msg->BuildHdrVal(dns_DNSKEY, 1),
+                                   msg->BuildAnswerVal(dns_DNSKEY, 2), msg->BuildDNSKEY_Val(&dnskey));
     }
 
     return true;
@@ -1011,7 +1075,8 @@ bool DNS_Interpreter::ParseRR_NSEC(detail::DNS_MsgInfo* msg, const u_char*& data
     }
 
     if ( dns_NSEC )
-        analyzer->EnqueueConnEvent(dns_NSEC, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
+        analyzer->EnqueueConnEvent(dns_NSEC, analyzer->ConnVal(), msg->BuildHdrVal(dns_NSEC, 1),
+                                   msg->BuildAnswerVal(dns_NSEC, 2),
                                    make_intrusive<StringVal>(new String(name, name_end - name, true)),
                                    std::move(char_strings));
 
@@ -1085,8 +1150,8 @@ bool DNS_Interpreter::ParseRR_NSEC3(detail::DNS_MsgInfo* msg, const u_char*& dat
         nsec3.nsec_hash = hash_val;
         nsec3.bitmaps = std::move(char_strings);
 
-        analyzer->EnqueueConnEvent(dns_NSEC3, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildNSEC3_Val(&nsec3));
+        analyzer->EnqueueConnEvent(dns_NSEC3, analyzer->ConnVal(), msg->BuildHdrVal(dns_NSEC3, 1),
+                                   msg->BuildAnswerVal(dns_NSEC3, 2), msg->BuildNSEC3_Val(&nsec3));
     }
 
     return true;
@@ -1126,8 +1191,8 @@ bool DNS_Interpreter::ParseRR_NSEC3PARAM(detail::DNS_MsgInfo* msg, const u_char*
         nsec3param.nsec_salt_len = salt_len;
         nsec3param.nsec_salt = salt_value;
 
-        analyzer->EnqueueConnEvent(dns_NSEC3PARAM, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildNSEC3PARAM_Val(&nsec3param));
+        analyzer->EnqueueConnEvent(dns_NSEC3PARAM, analyzer->ConnVal(), msg->BuildHdrVal(dns_NSEC3PARAM, 1),
+                                   msg->BuildAnswerVal(dns_NSEC3PARAM, 2), msg->BuildNSEC3PARAM_Val(&nsec3param));
     }
 
     return true;
@@ -1168,8 +1233,8 @@ bool DNS_Interpreter::ParseRR_DS(detail::DNS_MsgInfo* msg, const u_char*& data,
         ds.digest_type = ds_dtype;
         ds.digest_val = ds_digest;
 
-        analyzer->EnqueueConnEvent(dns_DS, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildDS_Val(&ds));
+        analyzer->EnqueueConnEvent(dns_DS, analyzer->ConnVal(), msg->BuildHdrVal(dns_DS, 1),
+                                   msg->BuildAnswerVal(dns_DS, 2), msg->BuildDS_Val(&ds));
     }
 
     return true;
@@ -1204,8 +1269,8 @@ bool DNS_Interpreter::ParseRR_BINDS(detail::DNS_MsgInfo* msg, const u_char*& dat
         binds.removal_flag = rmflag;
         binds.complete_flag = completeflag;
 
-        analyzer->EnqueueConnEvent(dns_BINDS, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildBINDS_Val(&binds));
+        analyzer->EnqueueConnEvent(dns_BINDS, analyzer->ConnVal(), msg->BuildHdrVal(dns_BINDS, 1),
+                                   msg->BuildAnswerVal(dns_BINDS, 2), msg->BuildBINDS_Val(&binds));
     }
 
     return true;
@@ -1229,8 +1294,8 @@ bool DNS_Interpreter::ParseRR_SSHFP(detail::DNS_MsgInfo* msg, const u_char*& dat
     String* fingerprint = ExtractStream(data, len, rdlength - 2);
 
     if ( dns_SSHFP ) {
-        analyzer->EnqueueConnEvent(dns_SSHFP, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   val_mgr->Count(algo), val_mgr->Count(fptype),
+        analyzer->EnqueueConnEvent(dns_SSHFP, analyzer->ConnVal(), msg->BuildHdrVal(dns_SSHFP, 1),
+                                   msg->BuildAnswerVal(dns_SSHFP, 2), val_mgr->Count(algo), val_mgr->Count(fptype),
                                    make_intrusive<StringVal>(fingerprint));
     }
 
@@ -1276,8 +1341,8 @@ bool DNS_Interpreter::ParseRR_LOC(detail::DNS_MsgInfo* msg, const u_char*& data,
         loc.longitude = longitude;
         loc.altitude = altitude;
 
-        analyzer->EnqueueConnEvent(dns_LOC, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   msg->BuildLOC_Val(&loc));
+        analyzer->EnqueueConnEvent(dns_LOC, analyzer->ConnVal(), msg->BuildHdrVal(dns_LOC, 1),
+                                   msg->BuildAnswerVal(dns_LOC, 2), msg->BuildLOC_Val(&loc));
     }
 
     return true;
@@ -1291,9 +1356,12 @@ bool DNS_Interpreter::ParseRR_A(detail::DNS_MsgInfo* msg, const u_char*& data, i
 
     uint32_t addr = ExtractLong(data, len);
 
-    if ( dns_A_reply && ! msg->skip_event )
-        analyzer->EnqueueConnEvent(dns_A_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   make_intrusive<AddrVal>(htonl(addr)));
+    if ( auto rr = msg->AddRR() )
+        rr->Assign(1, make_intrusive<AddrVal>(htonl(addr)));
+
+    else if ( dns_A_reply && ! msg->skip_event )
+        analyzer->EnqueueConnEvent(dns_A_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_A_reply, 1),
+                                   msg->BuildAnswerVal(dns_A_reply, 2), make_intrusive<AddrVal>(htonl(addr)));
 
     return true;
 }
@@ -1319,9 +1387,12 @@ bool DNS_Interpreter::ParseRR_AAAA(detail::DNS_MsgInfo* msg, const u_char*& data
     else
         event = dns_A6_reply;
 
-    if ( event && ! msg->skip_event )
-        analyzer->EnqueueConnEvent(event, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   make_intrusive<AddrVal>(addr));
+    if ( auto rr = msg->AddRR() )
+        rr->Assign(1, make_intrusive<AddrVal>(addr));
+
+    else if ( event && ! msg->skip_event )
+        analyzer->EnqueueConnEvent(event, analyzer->ConnVal(), msg->BuildHdrVal(event, 1),
+                                   msg->BuildAnswerVal(event, 2), make_intrusive<AddrVal>(addr));
 
     return true;
 }
@@ -1334,7 +1405,8 @@ bool DNS_Interpreter::ParseRR_WKS(detail::DNS_MsgInfo* msg, const u_char*& data,
     }
 
     // TODO: Pass the ports as parameters to the event
-    analyzer->EnqueueConnEvent(dns_WKS_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal());
+    analyzer->EnqueueConnEvent(dns_WKS_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_WKS_reply, 1),
+                               msg->BuildAnswerVal(dns_WKS_reply, 2));
 
     // TODO: Return a status which reflects if the port parameters were successfully parsed
     return true;
@@ -1374,15 +1446,15 @@ bool DNS_Interpreter::ParseRR_HINFO(detail::DNS_MsgInfo* msg, const u_char*& dat
     auto cpu = extract_char_string(analyzer, data, len, rdlength);
     auto os = extract_char_string(analyzer, data, len, rdlength);
 
-    analyzer->EnqueueConnEvent(dns_HINFO_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(), cpu,
-                               os);
+    analyzer->EnqueueConnEvent(dns_HINFO_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_HINFO_reply, 1),
+                               msg->BuildAnswerVal(dns_HINFO_reply, 2), cpu, os);
 
     return rdlength == 0;
 }
 
 bool DNS_Interpreter::ParseRR_TXT(detail::DNS_MsgInfo* msg, const u_char*& data, int& len, int rdlength,
                                   const u_char* msg_start) {
-    if ( ! dns_TXT_reply || msg->skip_event ) {
+    if ( (! dns_TXT_reply && ! msg->batch_replies) || msg->skip_event ) {
         data += rdlength;
         len -= rdlength;
         return true;
@@ -1394,16 +1466,19 @@ bool DNS_Interpreter::ParseRR_TXT(detail::DNS_MsgInfo* msg, const u_char*& data,
     while ( (char_string = extract_char_string(analyzer, data, len, rdlength)) )
         char_strings->Assign(char_strings->Size(), std::move(char_string));
 
-    if ( dns_TXT_reply )
-        analyzer->EnqueueConnEvent(dns_TXT_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   std::move(char_strings));
+    if ( auto rr = msg->AddRR() )
+        rr->Assign(3, std::move(char_strings));
+
+    else if ( dns_TXT_reply )
+        analyzer->EnqueueConnEvent(dns_TXT_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_TXT_reply, 1),
+                                   msg->BuildAnswerVal(dns_TXT_reply, 2), std::move(char_strings));
 
     return rdlength == 0;
 }
 
 bool DNS_Interpreter::ParseRR_SPF(detail::DNS_MsgInfo* msg, const u_char*& data, int& len, int rdlength,
                                   const u_char* msg_start) {
-    if ( ! dns_SPF_reply || msg->skip_event ) {
+    if ( (! dns_SPF_reply && ! msg->batch_replies) || msg->skip_event ) {
         data += rdlength;
         len -= rdlength;
         return true;
@@ -1415,9 +1490,12 @@ bool DNS_Interpreter::ParseRR_SPF(detail::DNS_MsgInfo* msg, const u_char*& data,
     while ( (char_string = extract_char_string(analyzer, data, len, rdlength)) )
         char_strings->Assign(char_strings->Size(), std::move(char_string));
 
-    if ( dns_SPF_reply )
-        analyzer->EnqueueConnEvent(dns_SPF_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   std::move(char_strings));
+    if ( auto rr = msg->AddRR() )
+        rr->Assign(3, std::move(char_strings));
+
+    else if ( dns_SPF_reply )
+        analyzer->EnqueueConnEvent(dns_SPF_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_SPF_reply, 1),
+                                   msg->BuildAnswerVal(dns_SPF_reply, 2), std::move(char_strings));
 
     return rdlength == 0;
 }
@@ -1449,9 +1527,9 @@ bool DNS_Interpreter::ParseRR_CAA(detail::DNS_MsgInfo* msg, const u_char*& data,
     rdlength -= value->Len();
 
     if ( dns_CAA_reply )
-        analyzer->EnqueueConnEvent(dns_CAA_reply, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                   val_mgr->Count(flags), make_intrusive<StringVal>(tag),
-                                   make_intrusive<StringVal>(value));
+        analyzer->EnqueueConnEvent(dns_CAA_reply, analyzer->ConnVal(), msg->BuildHdrVal(dns_CAA_reply, 1),
+                                   msg->BuildAnswerVal(dns_CAA_reply, 2), val_mgr->Count(flags),
+                                   make_intrusive<StringVal>(tag), make_intrusive<StringVal>(value));
     else {
         delete tag;
         delete value;
@@ -1500,12 +1578,12 @@ bool DNS_Interpreter::ParseRR_SVCB(detail::DNS_MsgInfo* msg, const u_char*& data
 
     switch ( svcb_type ) {
         case detail::TYPE_SVCB:
-            analyzer->EnqueueConnEvent(dns_SVCB, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                       msg->BuildSVCB_Val(svcb_data));
+            analyzer->EnqueueConnEvent(dns_SVCB, analyzer->ConnVal(), msg->BuildHdrVal(dns_SVCB, 1),
+                                       msg->BuildAnswerVal(dns_SVCB, 2), msg->BuildSVCB_Val(svcb_data));
             break;
         case detail::TYPE_HTTPS:
-            analyzer->EnqueueConnEvent(dns_HTTPS, analyzer->ConnVal(), msg->BuildHdrVal(), msg->BuildAnswerVal(),
-                                       msg->BuildSVCB_Val(svcb_data));
+            analyzer->EnqueueConnEvent(dns_HTTPS, analyzer->ConnVal(), msg->BuildHdrVal(dns_HTTPS, 1),
+                                       msg->BuildAnswerVal(dns_HTTPS, 2), msg->BuildSVCB_Val(svcb_data));
             break;
         default: break; // unreachable. for suppressing compiler warnings.
     }
@@ -1519,8 +1597,9 @@ void DNS_Interpreter::SendReplyOrRejectEvent(detail::DNS_MsgInfo* msg, EventHand
 
     assert(event);
 
-    analyzer->EnqueueConnEvent(event, analyzer->ConnVal(), msg->BuildHdrVal(), make_intrusive<StringVal>(question_name),
-                               val_mgr->Count(qtype), val_mgr->Count(qclass), make_intrusive<StringVal>(original_name));
+    analyzer->EnqueueConnEvent(event, analyzer->ConnVal(), msg->BuildHdrVal(event, 1),
+                               make_intrusive<StringVal>(question_name), val_mgr->Count(qtype), val_mgr->Count(qclass),
+                               make_intrusive<StringVal>(original_name));
 }
 
 DNS_MsgInfo::DNS_MsgInfo(DNS_RawMsgHdr* hdr, int arg_is_query) {
@@ -1553,6 +1632,7 @@ DNS_MsgInfo::DNS_MsgInfo(DNS_RawMsgHdr* hdr, int arg_is_query) {
 
     answer_type = DNS_QUESTION;
     skip_event = 0;
+    batch_replies = false;
 }
 
 RecordValPtr DNS_MsgInfo::BuildHdrVal() {
@@ -1591,6 +1671,39 @@ RecordValPtr DNS_MsgInfo::BuildAnswerVal() {
     return r;
 }
 
+RecordValPtr DNS_MsgInfo::BuildHdrVal(const EventHandlerPtr& e, int idx) {
+    if ( e->ParamUsed(idx) )
+        return BuildHdrVal();
+
+    static auto placeholder = make_intrusive<RecordVal>(id::find_type<RecordType>("dns_msg"));
+    return placeholder;
+}
+
+RecordValPtr DNS_MsgInfo::BuildAnswerVal(const EventHandlerPtr& e, int idx) {
+    if ( e->ParamUsed(idx) )
+        return BuildAnswerVal();
+
+    static auto placeholder = make_intrusive<RecordVal>(id::find_type<RecordType>("dns_answer"));
+    return placeholder;
+}
+
+RecordValPtr DNS_MsgInfo::AddRR() {
+    if ( ! batch_replies || skip_event )
+        return nullptr;
+
+    static auto dns_rr = id::find_type<RecordType>("dns_rr");
+    static auto dns_rr_vec = id::find_type<VectorType>("dns_rr_vec");
+
+    if ( ! rrs )
+        rrs = make_intrusive<VectorVal>(dns_rr_vec);
+
+    auto r = make_intrusive<RecordVal>(dns_rr);
+    r->Assign(0, BuildAnswerVal());
+    rrs->Append(r);
+
+    return r;
+}
+
 RecordValPtr DNS_MsgInfo::BuildEDNS_Val() {
     // We have to treat the additional record type in EDNS differently
     // than a regular resource record.
@@ -274,6 +274,12 @@ public:
 
     RecordValPtr BuildHdrVal();
     RecordValPtr BuildAnswerVal();
+
+    // Same as the above for passing the record as parameter idx of event e,
+    // except that an empty placeholder is returned when the parameter goes
+    // unused (see EventHandler::ParamUsed()).
+    RecordValPtr BuildHdrVal(const EventHandlerPtr& e, int idx);
+    RecordValPtr BuildAnswerVal(const EventHandlerPtr& e, int idx);
     RecordValPtr BuildEDNS_Val();
     RecordValPtr BuildEDNS_ECS_Val(struct EDNS_ECS*);
     RecordValPtr BuildEDNS_TCP_KA_Val(struct EDNS_TCP_KEEPALIVE*);
@@ -288,6 +294,12 @@ public:
     RecordValPtr BuildLOC_Val(struct LOC_DATA*);
     RecordValPtr BuildSVCB_Val(const struct SVCB_DATA&);
 
+    // Returns a new dns_rr record for the current RR, holding its general
+    // part and appended to the ones that dns_replies delivers, for the
+    // caller to fill in the type-specific fields. Returns null if the RR
+    // goes through its individual reply event instead.
+    RecordValPtr AddRR();
+
     int id;
     int opcode;   ///< query type, see DNS_Opcode
     int rcode;    ///< return code, see DNS_Code
@@ -312,6 +324,9 @@ public:
 
     DNS_AnswerType answer_type;
     int skip_event; ///< if true, don't generate corresponding events
+
+    bool batch_replies; ///< if true, collect RRs for dns_replies, see AddRR()
+    VectorValPtr rrs;   ///< RRs collected for dns_replies
     // int answer_count;	///< count of responders.  if >1 and not
     ///< identical answer, there may be problems
     // uint32* addr;	///< cache value to pass back results
@@ -329,6 +344,9 @@ public:
 protected:
     void EndMessage(detail::DNS_MsgInfo* msg);
 
+    // Raises dns_replies for the records collected so far, if any.
+    void SendReplies(detail::DNS_MsgInfo* msg);
+
     bool ParseQuestions(detail::DNS_MsgInfo* msg, const u_char*& data, int& len, const u_char* start);
     bool ParseAnswers(detail::DNS_MsgInfo* msg, int n, detail::DNS_AnswerType answer_type, const u_char*& data,
                       int& len, const u_char* start);
@@ -1143,7 +1143,7 @@ int HTTP_Analyzer::HTTP_RequestLine(const char* line, const char* end_of_line) {
             goto error;
     }
 
-    request_method = make_intrusive<StringVal>(end_of_method - line, line);
+    request_method = val_mgr->InternedString({line, static_cast<size_t>(end_of_method - line)});
 
     Conn()->Match(zeek::detail::Rule::HTTP_REQUEST, (const u_char*)unescaped_URI->AsString()->Bytes(),
                   unescaped_URI->AsString()->Len(), true, true, true, true);
@@ -1267,14 +1267,14 @@ void HTTP_Analyzer::HTTP_Request() {
     if ( http_request )
         // DEBUG_MSG("%.6f http_request\n", run_state::network_time);
         EnqueueConnEvent(http_request, ConnVal(), request_method, TruncateURI(request_URI), TruncateURI(unescaped_URI),
-                         make_intrusive<StringVal>(util::fmt("%.1f", request_version.ToDouble())));
+                         val_mgr->InternedString(util::fmt("%.1f", request_version.ToDouble())));
 }
 
 void HTTP_Analyzer::HTTP_Reply() {
     if ( http_reply )
-        EnqueueConnEvent(http_reply, ConnVal(), make_intrusive<StringVal>(util::fmt("%.1f", reply_version.ToDouble())),
+        EnqueueConnEvent(http_reply, ConnVal(), val_mgr->InternedString(util::fmt("%.1f", reply_version.ToDouble())),
                          val_mgr->Count(reply_code),
-                         reply_reason_phrase ? reply_reason_phrase : make_intrusive<StringVal>("<empty>"));
+                         reply_reason_phrase ? reply_reason_phrase : val_mgr->InternedString("<empty>"));
     else
         reply_reason_phrase = nullptr;
 }
@@ -1531,11 +1531,25 @@ void HTTP_Analyzer::HTTP_Header(bool is_orig, analyzer::mime::MIME_Header* h) {
         if ( DEBUG_http )
             DEBUG_MSG("%.6f http_header\n", run_state::network_time);
 
-        auto upper_hn = analyzer::mime::to_string_val(h->get_name());
-        upper_hn->ToUpper();
+        // Handlers mostly use the alternate prototype without original_name,
+        // so build only the strings that get read.
+        StringValPtr orig_hn = val_mgr->EmptyString();
+        StringValPtr upper_hn = val_mgr->EmptyString();
+        StringValPtr value = val_mgr->EmptyString();
 
-        EnqueueConnEvent(http_header, ConnVal(), val_mgr->Bool(is_orig), analyzer::mime::to_string_val(h->get_name()),
-                         std::move(upper_hn), analyzer::mime::to_string_val(h->get_value()));
+        if ( http_header->ParamUsed(2) )
+            orig_hn = analyzer::mime::to_string_val(h->get_name());
+
+        if ( http_header->ParamUsed(3) ) {
+            upper_hn = analyzer::mime::to_string_val(h->get_name());
+            upper_hn->ToUpper();
+        }
+
+        if ( http_header->ParamUsed(4) )
+            value = analyzer::mime::to_string_val(h->get_value());
+
+        EnqueueConnEvent(http_header, ConnVal(), val_mgr->Bool(is_orig), std::move(orig_hn), std::move(upper_hn),
+                         std::move(value));
     }
 }
 
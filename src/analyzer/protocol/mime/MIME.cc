@@ -3,6 +3,7 @@
 #include "zeek/zeek-config.h"
 
 #include <openssl/evp.h>
+#include <cstring>
 
 #include "zeek/Base64.h"
 #include "zeek/NetVar.h"
@@ -373,19 +374,16 @@ String* MIME_decode_quoted_pairs(data_chunk_t buf) {
 
 MIME_Multiline::MIME_Multiline() { line = nullptr; }
 
-MIME_Multiline::~MIME_Multiline() {
-    delete line;
-    delete_strings(buffer);
-}
+MIME_Multiline::~MIME_Multiline() { delete line; }
 
-void MIME_Multiline::append(int len, const char* data) { buffer.push_back(new String((const u_char*)data, len, true)); }
+void MIME_Multiline::append(int len, const char* data) { buffer.append(data, len); }
 
 String* MIME_Multiline::get_concatenated_line() {
     if ( buffer.empty() )
         return nullptr;
 
     delete line;
-    line = concatenate(buffer);
+    line = new String(reinterpret_cast<const u_char*>(buffer.data()), buffer.size(), true);
 
     return line;
 }
@@ -468,8 +466,11 @@ void MIME_Entity::init() {
 
     need_to_parse_parameters = 0;
 
-    content_type_str = make_intrusive<StringVal>("TEXT");
-    content_subtype_str = make_intrusive<StringVal>("PLAIN");
+    // Most entities keep the defaults, so they share a single instance.
+    static auto default_type = make_intrusive<StringVal>("TEXT");
+    static auto default_subtype = make_intrusive<StringVal>("PLAIN");
+    content_type_str = default_type;
+    content_subtype_str = default_subtype;
 
     content_encoding_str = nullptr;
     multipart_boundary = nullptr;
@@ -847,16 +848,11 @@ int MIME_Entity::CheckBoundaryDelimiter(int len, const char* data) {
 
         data_chunk_t delim = get_data_chunk(multipart_boundary);
 
-        int i;
-        for ( i = 0; i < len && i < delim.length; ++i )
-            if ( data[i] != delim.data[i] )
-                return NOT_MULTIPART_BOUNDARY;
-
-        if ( i < delim.length )
+        if ( len < delim.length || memcmp(data, delim.data, delim.length) != 0 )
             return NOT_MULTIPART_BOUNDARY;
 
-        len -= i;
-        data += i;
+        len -= delim.length;
+        data += delim.length;
 
         if ( len >= 2 && data[0] == '-' && data[1] == '-' )
             return MULTIPART_CLOSING_BOUNDARY;
@@ -1240,8 +1236,13 @@ void MIME_Mail::EndEntity(MIME_Entity* /* entity */) {
 }
 
 void MIME_Mail::SubmitHeader(MIME_Header* h) {
-    if ( mime_one_header )
-        analyzer->EnqueueConnEvent(mime_one_header, analyzer->ConnVal(), ToHeaderVal(h));
+    if ( ! mime_one_header )
+        return;
+
+    static auto placeholder = make_intrusive<RecordVal>(id::find_type<RecordType>("mime_header_rec"));
+
+    analyzer->EnqueueConnEvent(mime_one_header, analyzer->ConnVal(),
+                               mime_one_header->ParamUsed(1) ? ToHeaderVal(h) : placeholder);
 }
 
 void MIME_Mail::SubmitAllHeaders(MIME_HeaderList& hlist) {
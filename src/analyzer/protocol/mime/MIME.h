@@ -3,6 +3,7 @@
 #include <cassert>
 #include <cstdio>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "zeek/Reporter.h"
@@ -66,7 +67,7 @@ public:
     String* get_concatenated_line();
 
 protected:
-    std::vector<const String*> buffer;
+    std::string buffer; // The header's lines, appended as they come in.
     String* line;
 };
 
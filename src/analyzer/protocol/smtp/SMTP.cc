@@ -222,7 +222,9 @@ void SMTP_Analyzer::ProcessLine(int length, const char* line, bool orig) {
             ProcessData(data_len, line);
 
             if ( smtp_data && ! skip_data ) {
-                EnqueueConnEvent(smtp_data, ConnVal(), val_mgr->Bool(orig), make_intrusive<StringVal>(data_len, line));
+                auto cl = orig ? cl_orig : cl_resp;
+                EnqueueConnEvent(smtp_data, ConnVal(), val_mgr->Bool(orig),
+                                 cl->LineVal(data_len, reinterpret_cast<const u_char*>(line)));
             }
         }
 
@@ -808,8 +810,7 @@ void SMTP_Analyzer::RequestEvent(int cmd_len, const char* cmd, int arg_len, cons
     AnalyzerConfirmation();
 
     if ( smtp_request ) {
-        auto cmd_arg = make_intrusive<StringVal>(cmd_len, cmd);
-        cmd_arg->ToUpper();
+        auto cmd_arg = val_mgr->InternedString(util::strtoupper(std::string(cmd, cmd_len)));
 
         EnqueueConnEvent(smtp_request, ConnVal(), val_mgr->Bool(orig_is_sender), std::move(cmd_arg),
                          make_intrusive<StringVal>(arg_len, arg));
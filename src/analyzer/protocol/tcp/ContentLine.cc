@@ -1,11 +1,56 @@
 #include "zeek/analyzer/protocol/tcp/ContentLine.h"
 
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "zeek/Reporter.h"
 #include "zeek/analyzer/protocol/tcp/TCP.h"
 #include "zeek/analyzer/protocol/tcp/events.bif.h"
 
 namespace zeek::analyzer::tcp {
 
+namespace {
+
+// Lines shorter than this are copied by LineVal() rather than borrowed.
+constexpr int MIN_BORROWED_LINE_LENGTH = 256;
+
+// Returns the number of leading bytes of data that need no special treatment
+// by DoDeliverOnce(), i.e., that are neither CR nor LF, nor NUL if nul is set.
+int count_plain_chars(const u_char* data, int len, bool nul) {
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+
+    for ( ; i + 16 <= len; i += 16 ) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf));
+
+        if ( nul )
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, zero));
+
+        if ( int mask = _mm_movemask_epi8(hits) )
+            return i + __builtin_ctz(mask);
+    }
+#endif
+
+    for ( ; i < len; ++i ) {
+        u_char c = data[i];
+
+        if ( c == '\r' || c == '\n' || (c == '\0' && nul) )
+            break;
+    }
+
+    return i;
+}
+
+} // namespace
+
 ContentLine_Analyzer::ContentLine_Analyzer(Connection* conn, bool orig, int max_line_length)
     : TCP_SupportAnalyzer("CONTENTLINE", conn, orig), max_line_length(max_line_length) {
     InitState();
@@ -36,34 +81,51 @@ void ContentLine_Analyzer::InitState() {
 }
 
 void ContentLine_Analyzer::InitBuffer(int size) {
-    if ( buf && buf_len >= size )
+    if ( buf && buf_len >= size && ! line_buffer->Shared() )
         // Don't shrink the buffer, because it's not clear in that
         // case how to deal with characters in it that no longer fit.
         return;
 
+    if ( buf && line_buffer->Shared() )
+        // We're replacing a buffer that's still borrowed by a StringVal.
+        // Size the new one for the partial line it takes over, not after
+        // the old one, which may have grown for a single long line.
+        size = std::max(size, 2 * offset);
+
     if ( size < 128 )
         size = 128;
 
-    u_char* b = new u_char[size];
+    auto b = make_intrusive<zeek::detail::StringBuffer>(size);
 
     if ( buf ) {
         if ( offset > 0 )
-            memcpy(b, buf, offset);
-        delete[] buf;
+            memcpy(b->Data(), buf, offset);
     }
     else {
         offset = 0;
         last_char = 0;
     }
 
-    buf = b;
+    line_buffer = std::move(b);
+    buf = line_buffer->Data();
     buf_len = size;
 }
 
-ContentLine_Analyzer::~ContentLine_Analyzer() { delete[] buf; }
+ContentLine_Analyzer::~ContentLine_Analyzer() {}
 
 bool ContentLine_Analyzer::HasPartialLine() const { return buf && offset > 0; }
 
+StringValPtr ContentLine_Analyzer::LineVal(int len, const u_char* line) const {
+    // A borrowed line pins the whole buffer for as long as its value lives,
+    // which may be well past the event if a script stores it.  Short lines
+    // are cheap to copy, as are those that fill only a small part of a
+    // (grown) buffer, so we borrow only where it saves a sizable copy.
+    if ( len < MIN_BORROWED_LINE_LENGTH || len < buf_len / 2 )
+        return make_intrusive<StringVal>(len, reinterpret_cast<const char*>(line));
+
+    return make_intrusive<StringVal>(line_buffer, len, line);
+}
+
 void ContentLine_Analyzer::DeliverStream(int len, const u_char* data, bool is_orig) {
     TCP_SupportAnalyzer::DeliverStream(len, data, is_orig);
 
@@ -197,6 +259,10 @@ int ContentLine_Analyzer::DoDeliverOnce(int len, const u_char* data) {
     if ( len <= 0 )
         return 0;
 
+    if ( line_buffer->Shared() )
+        // The previous line got borrowed, don't overwrite it.
+        InitBuffer(0);
+
     for ( ; len > 0; --len, ++data ) {
         if ( offset >= buf_len )
             InitBuffer(buf_len * 2);
@@ -220,6 +286,33 @@ int ContentLine_Analyzer::DoDeliverOnce(int len, const u_char* data) {
             EMIT_LINE
         }
 
+        // Copy runs of characters without special meaning in one go,
+        // stopping short of max_line_length so that the check above still
+        // triggers at the same character as it would byte by byte.
+        if ( int n = count_plain_chars(data, std::min(len, max_line_length - offset), flag_NULs); n > 0 ) {
+            if ( offset + n > buf_len ) {
+                int new_len = buf_len;
+                while ( new_len < offset + n )
+                    new_len *= 2;
+
+                InitBuffer(new_len);
+            }
+
+            memcpy(buf + offset, data, n);
+            offset += n;
+
+            if ( last_char == '\r' )
+                if ( ! suppress_weirds && Conn()->FlagEvent(SINGULAR_CR) )
+                    Weird("line_terminated_with_single_CR");
+
+            last_char = data[n - 1];
+
+            // The loop header advances past the last of the copied bytes.
+            len -= n - 1;
+            data += n - 1;
+            continue;
+        }
+
         switch ( c ) {
             case '\r':
                 // Look ahead for '\n'.
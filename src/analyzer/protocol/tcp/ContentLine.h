@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "zeek/Val.h"
+#include "zeek/ZeekString.h"
 #include "zeek/analyzer/protocol/tcp/TCP.h"
 
 namespace zeek::analyzer::tcp {
@@ -59,6 +61,14 @@ public:
 
     bool IsSkippedContents(uint64_t seq, int64_t length) { return seq + length <= seq_to_skip; }
 
+    // Returns a StringVal for (part of) a line that this analyzer has
+    // just forwarded, borrowing it from the line buffer rather than
+    // copying it if possible.  Only long lines that fill most of the
+    // buffer are borrowed; shorter ones are copied so that a stored value
+    // doesn't keep a large buffer alive.  Once borrowed, the buffer is left
+    // to the StringVal and subsequent lines are assembled in a fresh one.
+    StringValPtr LineVal(int len, const u_char* line) const;
+
 protected:
     ContentLine_Analyzer(const char* name, Connection* conn, bool orig, int max_line_length = DEFAULT_MAX_LINE_LENGTH);
 
@@ -76,7 +86,8 @@ protected:
     // Returns the sequence number delivered so far.
     uint64_t SeqDelivered() const { return seq_delivered_in_lines; }
 
-    u_char* buf;            // where we build up the body of the request
+    zeek::detail::StringBufferPtr line_buffer; // backs buf; shared with borrowed lines
+    u_char* buf;                               // where we build up the body of the request
     int offset;             // where we are in buf
     int buf_len;            // how big buf is, total
     unsigned int last_char; // last (non-option) character scanned
@@ -2,14 +2,56 @@
 
 #include "zeek/analyzer/protocol/zip/ZIP.h"
 
+#include "zeek/analyzer/protocol/zip/consts.bif.h"
+#include "zeek/telemetry/Manager.h"
+
 namespace zeek::analyzer::zip {
 
+namespace {
+
+// Size of the windows the inflated output gets forwarded in.
+constexpr unsigned int window_size = 4096;
+
+// Number of analyzers holding inflate state, see ZIP::max_active_streams.
+uint64_t active_streams = 0;
+
+struct Counters {
+    telemetry::CounterPtr compressed;
+    telemetry::CounterPtr decompressed;
+    telemetry::CounterPtr output_limit;
+    telemetry::CounterPtr stream_limit;
+};
+
+Counters& counters() {
+    static Counters c = []() {
+        auto bytes = telemetry_mgr->CounterFamily("zeek", "zip-bytes", {"kind"},
+                                                  "Bytes passed through ZIP decompression");
+        auto limits = telemetry_mgr->CounterFamily("zeek", "zip-limits-reached", {"limit"},
+                                                   "Number of times a ZIP decompression limit was hit");
+
+        return Counters{bytes->GetOrAdd({{"kind", "compressed"}}), bytes->GetOrAdd({{"kind", "decompressed"}}),
+                        limits->GetOrAdd({{"limit", "max_output_bytes"}}),
+                        limits->GetOrAdd({{"limit", "max_active_streams"}})};
+    }();
+
+    return c;
+}
+
+} // namespace
+
 ZIP_Analyzer::ZIP_Analyzer(Connection* conn, bool orig, Method arg_method)
     : analyzer::tcp::TCP_SupportAnalyzer("ZIP", conn, orig) {
     zip = nullptr;
     zip_status = Z_OK;
     method = arg_method;
 
+    if ( BifConst::ZIP::max_active_streams > 0 && active_streams >= BifConst::ZIP::max_active_streams ) {
+        counters().stream_limit->Inc();
+        Weird("inflate_stream_limit_reached");
+        zip_status = Z_STREAM_ERROR;
+        return;
+    }
+
     zip = new z_stream;
     zip->zalloc = 0;
     zip->zfree = 0;
@@ -25,16 +67,31 @@ ZIP_Analyzer::ZIP_Analyzer(Connection* conn, bool orig, Method arg_method)
         Weird("inflate_init_failed");
         delete zip;
         zip = nullptr;
+        zip_status = Z_STREAM_ERROR;
+        return;
     }
+
+    active = true;
+    ++active_streams;
 }
 
-ZIP_Analyzer::~ZIP_Analyzer() { delete zip; }
+ZIP_Analyzer::~ZIP_Analyzer() {
+    EndInflate();
+    delete zip;
+}
 
 void ZIP_Analyzer::Done() {
     Analyzer::Done();
+    EndInflate();
+}
 
-    if ( zip )
-        inflateEnd(zip);
+void ZIP_Analyzer::EndInflate() {
+    if ( ! active )
+        return;
+
+    inflateEnd(zip);
+    active = false;
+    --active_streams;
 }
 
 void ZIP_Analyzer::DeliverStream(int len, const u_char* data, bool orig) {
@@ -43,8 +100,13 @@ void ZIP_Analyzer::DeliverStream(int len, const u_char* data, bool orig) {
     if ( ! len || zip_status != Z_OK )
         return;
 
-    static unsigned int unzip_size = 4096;
-    auto unzipbuf = std::make_unique<Bytef[]>(unzip_size);
+    auto& stats = counters();
+    stats.compressed->Inc(len);
+
+    // The window gets reused across deliveries, with each one forwarded
+    // before it's refilled.
+    if ( ! window )
+        window = std::make_unique<Bytef[]>(window_size);
 
     int allow_restart = 1;
 
@@ -55,20 +117,38 @@ void ZIP_Analyzer::DeliverStream(int len, const u_char* data, bool orig) {
     size_t orig_avail_in = zip->avail_in;
 
     while ( true ) {
-        zip->next_out = unzipbuf.get();
-        zip->avail_out = unzip_size;
+        zip->next_out = window.get();
+        zip->avail_out = window_size;
 
         zip_status = inflate(zip, Z_SYNC_FLUSH);
 
         if ( zip_status == Z_STREAM_END || zip_status == Z_OK ) {
             allow_restart = 0;
 
-            int have = unzip_size - zip->avail_out;
-            if ( have )
-                ForwardStream(have, unzipbuf.get(), IsOrig());
+            uint64_t have = window_size - zip->avail_out;
+            bool limit_reached = false;
+
+            if ( BifConst::ZIP::max_output_bytes > 0 && output_bytes + have > BifConst::ZIP::max_output_bytes ) {
+                have = BifConst::ZIP::max_output_bytes - output_bytes;
+                limit_reached = true;
+            }
+
+            if ( have ) {
+                output_bytes += have;
+                stats.decompressed->Inc(have);
+                ForwardStream(have, window.get(), IsOrig());
+            }
+
+            if ( limit_reached ) {
+                stats.output_limit->Inc();
+                Weird("inflate_output_limit_reached");
+                // Treat the stream as finished so that further input
+                // gets ignored.
+                zip_status = Z_STREAM_END;
+            }
 
             if ( zip_status == Z_STREAM_END ) {
-                inflateEnd(zip);
+                EndInflate();
                 return;
             }
 
@@ -82,6 +162,8 @@ void ZIP_Analyzer::DeliverStream(int len, const u_char* data, bool orig) {
             inflateEnd(zip);
 
             if ( inflateInit2(zip, -MAX_WBITS) != Z_OK ) {
+                active = false;
+                --active_streams;
                 Weird("inflate_init_failed");
                 return;
             }
@@ -5,11 +5,19 @@
 #include "zeek/zeek-config.h"
 
 #include <zlib.h>
+#include <memory>
 
 #include "zeek/analyzer/protocol/tcp/TCP.h"
 
 namespace zeek::analyzer::zip {
 
+/**
+ * Support analyzer inflating a gzip or deflate stream. The output gets
+ * forwarded in windows of a fixed size as the input comes in, so memory use
+ * doesn't depend on how well the data compresses. The bytes produced per
+ * stream, and the number of streams active at once, are bounded by
+ * ZIP::max_output_bytes and ZIP::max_active_streams.
+ */
 class ZIP_Analyzer final : public analyzer::tcp::TCP_SupportAnalyzer {
 public:
     enum Method { GZIP, DEFLATE };
@@ -22,10 +30,17 @@ public:
     void DeliverStream(int len, const u_char* data, bool orig) override;
 
 protected:
+    // Releases the zlib state, if still held.
+    void EndInflate();
+
     enum { NONE, ZIP_OK, ZIP_FAIL };
     z_stream* zip;
     int zip_status;
     Method method;
+
+    bool active = false;             // Whether zip holds inflate state.
+    uint64_t output_bytes = 0;       // Bytes produced so far.
+    std::unique_ptr<Bytef[]> window; // Output buffer, allocated on first use.
 };
 
 } // namespace zeek::analyzer::zip
@@ -5,6 +5,7 @@
 #include <broker/configuration.hh>
 #include <broker/zeek.hh>
 #include <unistd.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <string>
@@ -255,6 +256,8 @@ Manager::Manager(bool arg_use_real_time) {
     use_real_time = arg_use_real_time;
     peer_count = 0;
     log_batch_size = 0;
+    event_batch_size = 0;
+    event_batch_interval = 0.0;
     log_topic_func = nullptr;
     log_id_type = nullptr;
     writer_id_type = nullptr;
@@ -264,6 +267,14 @@ void Manager::InitPostScript() {
     DBG_LOG(DBG_BROKER, "Initializing");
 
     log_batch_size = get_option("Broker::log_batch_size")->AsCount();
+    event_batch_size = get_option("Broker::event_batch_size")->AsCount();
+    event_batch_interval = get_option("Broker::event_batch_interval")->AsInterval();
+
+    for ( const auto& [idx, n] : get_option("Broker::coalesce_events")->AsTableVal()->ToMap() ) {
+        auto name = idx->AsListVal()->Idx(0)->AsString()->CheckString();
+        coalesce_key_args[name] = n->AsCount();
+    }
+
     default_log_topic_prefix = get_option("Broker::default_log_topic_prefix")->AsString()->CheckString();
     log_topic_func = get_option("Broker::log_topic")->AsFunc();
     log_id_type = id::find_type("Log::ID")->AsEnumType();
@@ -378,6 +389,7 @@ void Manager::InitializeBrokerStoreForwarding() {
 }
 
 void Manager::Terminate() {
+    FlushEventBuffers();
     FlushLogBuffers();
 
     iosource_mgr->UnregisterFd(bstate->subscriber.fd(), this);
@@ -505,6 +517,7 @@ void Manager::Unpeer(const string& addr, uint16_t port) {
 
     DBG_LOG(DBG_BROKER, "Stopping to peer with %s:%" PRIu16, addr.c_str(), port);
 
+    FlushEventBuffers();
     FlushLogBuffers();
     bstate->endpoint.unpeer_nosync(addr, port);
 }
@@ -526,12 +539,89 @@ bool Manager::PublishEvent(string topic, std::string name, broker::vector args,
         return true;
 
     DBG_LOG(DBG_BROKER, "Publishing event: %s", RenderEvent(topic, name, args).c_str());
+
+    if ( event_batch_size > 1 ) {
+        BufferEvent(topic, std::move(name), std::move(args), ts);
+        return true;
+    }
+
     broker::zeek::Event ev(std::move(name), std::move(args), broker::to_timestamp(ts));
     bstate->endpoint.publish(std::move(topic), ev.move_data());
     ++statistics.num_events_outgoing;
     return true;
 }
 
+void Manager::BufferEvent(const std::string& topic, std::string name, broker::vector args, double ts) {
+    auto& eb = event_buffers[topic];
+
+    if ( auto it = coalesce_key_args.find(name); it != coalesce_key_args.end() ) {
+        auto num_key_args = std::min(it->second, args.size());
+        broker::vector key;
+        key.reserve(num_key_args + 1);
+        key.emplace_back(name);
+        key.insert(key.end(), args.begin(), args.begin() + num_key_args);
+
+        auto [pending, inserted] = eb.coalesced.emplace(broker::data{std::move(key)}, eb.events.size());
+
+        if ( ! inserted ) {
+            // Replace the pending event in place so that it keeps its position
+            // relative to the other events of the batch.
+            eb.events[pending->second] =
+                broker::zeek::Event(std::move(name), std::move(args), broker::to_timestamp(ts));
+            ++statistics.num_events_coalesced;
+            return;
+        }
+    }
+
+    if ( eb.events.empty() )
+        eb.first_buffered = run_state::network_time;
+
+    eb.events.emplace_back(std::move(name), std::move(args), broker::to_timestamp(ts));
+
+    if ( eb.events.size() >= event_batch_size || run_state::network_time - eb.first_buffered >= event_batch_interval )
+        FlushEventBuffer(topic, eb);
+}
+
+size_t Manager::FlushEventBuffer(const std::string& topic, EventBuffer& eb) {
+    if ( bstate->endpoint.is_shutdown() )
+        return 0;
+
+    auto num_events = eb.events.size();
+
+    if ( num_events == 0 )
+        return 0;
+
+    if ( num_events == 1 )
+        bstate->endpoint.publish(topic, eb.events.front().move_data());
+    else {
+        broker::zeek::BatchBuilder batch;
+
+        for ( auto& ev : eb.events )
+            batch.add(std::move(ev));
+
+        bstate->endpoint.publish(topic, batch.build());
+    }
+
+    auto delay = run_state::network_time - eb.first_buffered;
+    statistics.event_batch_delay += delay;
+    statistics.max_event_batch_delay = std::max(statistics.max_event_batch_delay, delay);
+    statistics.num_events_outgoing += num_events;
+    ++statistics.num_event_batches_outgoing;
+
+    eb.events.clear();
+    eb.coalesced.clear();
+    return num_events;
+}
+
+size_t Manager::FlushEventBuffers() {
+    auto rval = 0u;
+
+    for ( auto& [topic, eb] : event_buffers )
+        rval += FlushEventBuffer(topic, eb);
+
+    return rval;
+}
+
 bool Manager::PublishEvent(string topic, RecordVal* args) {
     if ( bstate->endpoint.is_shutdown() )
         return true;
@@ -559,6 +649,48 @@ bool Manager::PublishEvent(string topic, RecordVal* args) {
     return PublishEvent(std::move(topic), event_name, std::move(xs), run_state::network_time);
 }
 
+bool Manager::PublishEvent(std::string topic, ValPList* args, zeek::detail::Frame* frame) {
+    scoped_reporter_location srl{frame};
+
+    auto func = CheckEventArgs(*args);
+
+    if ( ! func )
+        return false;
+
+    // Convert the arguments straight into the outgoing message instead of
+    // going through a Broker::Event record: that would allocate a record and
+    // an opaque DataVal per argument only to copy the data out again below.
+    broker::vector xs;
+    xs.reserve(args->length() - 1);
+
+    for ( auto i = 1; i < args->length(); ++i ) {
+        auto arg = (*args)[i];
+
+        if ( same_type(arg->GetType(), detail::DataVal::ScriptDataType()) ) {
+            const auto& data_val = arg->AsRecordVal()->GetField(0);
+
+            if ( ! data_val ) {
+                Error("failed to convert param #%d of type %s to broker data", i, type_name(arg->GetType()->Tag()));
+                return false;
+            }
+
+            xs.emplace_back(static_cast<detail::DataVal*>(data_val.get())->data);
+            continue;
+        }
+
+        BrokerData data;
+
+        if ( ! data.Convert(arg) ) {
+            Error("failed to convert param #%d of type %s to broker data", i, type_name(arg->GetType()->Tag()));
+            return false;
+        }
+
+        xs.emplace_back(std::move(data.value_));
+    }
+
+    return PublishEvent(std::move(topic), func->Name(), std::move(xs), run_state::network_time);
+}
+
 bool Manager::PublishIdentifier(std::string topic, std::string id) {
     if ( bstate->endpoint.is_shutdown() )
         return true;
@@ -666,13 +798,9 @@ bool Manager::PublishLogWrite(EnumVal* stream, EnumVal* writer, string path, int
         return false;
     }
 
-    zeek::detail::BinarySerializationFormat fmt;
-    char* data;
-    int len;
-
-    fmt.StartWrite();
+    log_write_fmt.StartWrite();
 
-    bool success = fmt.Write(num_fields, "num_fields");
+    bool success = log_write_fmt.Write(num_fields, "num_fields");
 
     if ( ! success ) {
         reporter->Error("Failed to remotely log stream %s: num_fields serialization failed", stream_id);
@@ -680,15 +808,14 @@ bool Manager::PublishLogWrite(EnumVal* stream, EnumVal* writer, string path, int
     }
 
     for ( int i = 0; i < num_fields; ++i ) {
-        if ( ! vals[i]->Write(&fmt) ) {
+        if ( ! vals[i]->Write(&log_write_fmt) ) {
             reporter->Error("Failed to remotely log stream %s: field %d serialization failed", stream_id, i);
             return false;
         }
     }
 
-    len = fmt.EndWrite(&data);
-    std::string serial_data(data, len);
-    free(data);
+    std::string serial_data;
+    log_write_fmt.EndWrite(&serial_data);
 
     auto v = log_topic_func->Invoke(IntrusivePtr{NewRef{}, stream}, make_intrusive<StringVal>(path));
 
@@ -812,52 +939,56 @@ bool Manager::AutoUnpublishEvent(const string& topic, Val* event) {
     return true;
 }
 
-RecordVal* Manager::MakeEvent(ValPList* args, zeek::detail::Frame* frame) {
-    auto rval = new RecordVal(BifType::Record::Broker::Event);
-    auto arg_vec = make_intrusive<VectorVal>(vector_of_data_type);
-    rval->Assign(1, arg_vec);
-    Func* func = nullptr;
-    scoped_reporter_location srl{frame};
-
-    for ( auto i = 0; i < args->length(); ++i ) {
-        auto arg_val = (*args)[i];
-
-        if ( i == 0 ) {
-            // Event val must come first.
-
-            if ( arg_val->GetType()->Tag() != TYPE_FUNC ) {
-                Error("attempt to convert non-event into an event type");
-                return rval;
-            }
+const Func* Manager::CheckEventArgs(const ValPList& args) {
+    if ( args.length() == 0 || args[0]->GetType()->Tag() != TYPE_FUNC ) {
+        Error("attempt to convert non-event into an event type");
+        return nullptr;
+    }
 
-            func = arg_val->AsFunc();
+    // Event val must come first.
+    const Func* func = args[0]->AsFunc();
 
-            if ( func->Flavor() != FUNC_FLAVOR_EVENT ) {
-                Error("attempt to convert non-event into an event type");
-                return rval;
-            }
+    if ( func->Flavor() != FUNC_FLAVOR_EVENT ) {
+        Error("attempt to convert non-event into an event type");
+        return nullptr;
+    }
 
-            auto num_args = func->GetType()->Params()->NumFields();
+    auto num_args = func->GetType()->Params()->NumFields();
 
-            if ( num_args != args->length() - 1 ) {
-                Error("bad # of arguments: got %d, expect %d", args->length(), num_args + 1);
-                return rval;
-            }
+    if ( num_args != args.length() - 1 ) {
+        Error("bad # of arguments: got %d, expect %d", args.length(), num_args + 1);
+        return nullptr;
+    }
 
-            rval->Assign(0, func->Name());
-            continue;
-        }
+    const auto& expected_types = func->GetType()->ParamList()->GetTypes();
 
-        const auto& got_type = (*args)[i]->GetType();
-        const auto& expected_type = func->GetType()->ParamList()->GetTypes()[i - 1];
+    for ( auto i = 1; i < args.length(); ++i ) {
+        const auto& got_type = args[i]->GetType();
+        const auto& expected_type = expected_types[i - 1];
 
         if ( ! same_type(got_type, expected_type) ) {
-            rval->Remove(0);
             Error("event parameter #%d type mismatch, got %s, expect %s", i, type_name(got_type->Tag()),
                   type_name(expected_type->Tag()));
-            return rval;
+            return nullptr;
         }
+    }
 
+    return func;
+}
+
+RecordVal* Manager::MakeEvent(ValPList* args, zeek::detail::Frame* frame) {
+    auto rval = new RecordVal(BifType::Record::Broker::Event);
+    auto arg_vec = make_intrusive<VectorVal>(vector_of_data_type);
+    rval->Assign(1, arg_vec);
+    scoped_reporter_location srl{frame};
+
+    auto func = CheckEventArgs(*args);
+
+    if ( ! func )
+        return rval;
+
+    for ( auto i = 1; i < args->length(); ++i ) {
+        const auto& got_type = (*args)[i]->GetType();
         RecordValPtr data_val;
 
         if ( same_type(got_type, detail::DataVal::ScriptDataType()) )
@@ -866,7 +997,6 @@ RecordVal* Manager::MakeEvent(ValPList* args, zeek::detail::Frame* frame) {
             data_val = BrokerData::ToRecordVal((*args)[i]);
 
         if ( ! data_val->HasField(0) ) {
-            rval->Remove(0);
             Error("failed to convert param #%d of type %s to broker data", i, type_name(got_type->Tag()));
             return rval;
         }
@@ -874,6 +1004,7 @@ RecordVal* Manager::MakeEvent(ValPList* args, zeek::detail::Frame* frame) {
         arg_vec->Assign(i - 1, std::move(data_val));
     }
 
+    rval->Assign(0, func->Name());
     return rval;
 }
 
@@ -14,6 +14,7 @@
 #include <unordered_map>
 
 #include "zeek/IntrusivePtr.h"
+#include "zeek/SerializationFormat.h"
 #include "zeek/broker/Data.h"
 #include "zeek/iosource/IOSource.h"
 #include "zeek/logging/WriterBackend.h"
@@ -65,6 +66,15 @@ struct Stats {
     size_t num_ids_incoming = 0;
     // Number of total identifiers sent.
     size_t num_ids_outgoing = 0;
+    // Number of total event batches sent.
+    size_t num_event_batches_outgoing = 0;
+    // Number of total events replaced by a newer one while batched.
+    size_t num_events_coalesced = 0;
+    // Sum over all sent batches of their age at flush time, i.e., the time
+    // since their first event got buffered.
+    double event_batch_delay = 0.0;
+    // Longest time a batch was held before it got sent.
+    double max_event_batch_delay = 0.0;
 };
 
 /**
@@ -201,6 +211,19 @@ public:
      */
     bool PublishEvent(std::string topic, RecordVal* ev);
 
+    /**
+     * Send an event to any interested peers, converting its arguments
+     * directly into Broker data without creating a Broker::Event record
+     * first.
+     * @param topic a topic string associated with the message.
+     * @param args the event and its arguments.  The event is always the first
+     * element in the list.
+     * @param frame the calling frame, used to report location info upon error.
+     * @return true if the message is sent successfully, false if an invalid
+     * event or arguments were supplied.
+     */
+    bool PublishEvent(std::string topic, ValPList* args, zeek::detail::Frame* frame);
+
     /**
      * Send a message to create a log stream to any interested peers.
      * The log stream may or may not already exist on the receiving side.
@@ -357,6 +380,12 @@ public:
      */
     size_t FlushLogBuffers();
 
+    /**
+     * Send all pending event batches.
+     * @return the number of events sent.
+     */
+    size_t FlushEventBuffers();
+
     /**
      * Flushes all pending data store queries and also clears all contents.
      */
@@ -403,6 +432,11 @@ private:
 
     void Error(const char* format, ...) __attribute__((format(printf, 2, 3)));
 
+    // Validates that args holds an event followed by arguments matching its
+    // parameter types, reporting an error otherwise.  Returns the event's
+    // Func on success and nullptr on failure.
+    const Func* CheckEventArgs(const ValPList& args);
+
     // IOSource interface overrides:
     void Process() override;
     const char* Tag() override { return "Broker::Manager"; }
@@ -416,6 +450,19 @@ private:
         size_t Flush(broker::endpoint& endpoint, size_t batch_size);
     };
 
+    struct EventBuffer {
+        std::vector<broker::zeek::Event> events;
+        // Maps coalescing keys to the position of the pending event in events.
+        std::unordered_map<broker::data, size_t> coalesced;
+        // Network time at which the oldest pending event was buffered.
+        double first_buffered = 0.0;
+    };
+
+    // Adds an event to the batch for the given topic, coalescing it with a
+    // pending one if configured, and sends the batch once it's full or old.
+    void BufferEvent(const std::string& topic, std::string name, broker::vector args, double ts);
+    size_t FlushEventBuffer(const std::string& topic, EventBuffer& eb);
+
     // Data stores
     using query_id = std::pair<broker::request_id, detail::StoreHandleVal*>;
 
@@ -429,6 +476,7 @@ private:
     };
 
     std::vector<LogBuffer> log_buffers; // Indexed by stream ID enum.
+    std::unordered_map<std::string, EventBuffer> event_buffers; // Indexed by topic.
     std::string default_log_topic_prefix;
     std::shared_ptr<BrokerState> bstate;
     std::unordered_map<std::string, detail::StoreHandleVal*> data_stores;
@@ -438,11 +486,19 @@ private:
 
     Stats statistics;
 
+    // Serializes the fields of PublishLogWrite(). Kept around so that its
+    // output buffer gets reused rather than allocated for every record.
+    zeek::detail::BinarySerializationFormat log_write_fmt;
+
     uint16_t bound_port;
     bool use_real_time;
     int peer_count;
 
     size_t log_batch_size;
+    size_t event_batch_size;
+    double event_batch_interval;
+    // Number of leading arguments forming the coalescing key, by event name.
+    std::unordered_map<std::string, size_t> coalesce_key_args;
     Func* log_topic_func;
     VectorTypePtr vector_of_data_type;
     EnumType* log_id_type;
@@ -271,8 +271,7 @@ void File::InferMetadata() {
         if ( bof_buffer.size == 0 )
             return;
 
-        String* bs = concatenate(bof_buffer.chunks);
-        val->Assign(bof_buffer_idx, bs);
+        val->Assign(bof_buffer_idx, BOFBufferString());
         bof_buffer_val = val->GetField(bof_buffer_idx);
     }
 
@@ -300,23 +299,44 @@ bool File::BufferBOF(const u_char* data, uint64_t len) {
         return false;
 
     uint64_t desired_size = LookupFieldDefaultCount(bof_buffer_size_idx);
+    uint64_t needed = bof_buffer.size + len + 1;
 
-    bof_buffer.chunks.push_back(new String(data, len, false));
+    if ( ! bof_buffer.data || static_cast<uint64_t>(bof_buffer.data->Size()) < needed ) {
+        // Most files are small, so start out with just what the first chunk
+        // needs and grow geometrically up to the desired size.
+        uint64_t capacity = needed;
+
+        if ( bof_buffer.data )
+            capacity = std::max(needed, std::min(2 * static_cast<uint64_t>(bof_buffer.data->Size()), desired_size + 1));
+
+        auto b = make_intrusive<zeek::detail::StringBuffer>(capacity);
+
+        if ( bof_buffer.size > 0 )
+            memcpy(b->Data(), bof_buffer.data->Data(), bof_buffer.size);
+
+        bof_buffer.data = std::move(b);
+    }
+
+    memcpy(bof_buffer.data->Data() + bof_buffer.size, data, len);
     bof_buffer.size += len;
+    bof_buffer.data->Data()[bof_buffer.size] = '\0';
+    bof_buffer.chunk_lens.push_back(len);
 
     if ( bof_buffer.size < desired_size )
         return true;
 
     bof_buffer.full = true;
 
-    if ( bof_buffer.size > 0 ) {
-        String* bs = concatenate(bof_buffer.chunks);
-        val->Assign(bof_buffer_idx, bs);
-    }
+    if ( bof_buffer.size > 0 )
+        val->Assign(bof_buffer_idx, BOFBufferString());
 
     return false;
 }
 
+String* File::BOFBufferString() const {
+    return new String(bof_buffer.data, bof_buffer.data->Data(), bof_buffer.size);
+}
+
 void File::DeliverStream(const u_char* data, uint64_t len) {
     bool bof_was_full = bof_buffer.full;
     // Buffer enough data for the BOF buffer
@@ -329,6 +349,12 @@ void File::DeliverStream(const u_char* data, uint64_t len) {
             stream_offset, IsComplete() ? "complete" : "incomplete",
             util::fmt_bytes((const char*)data, std::min((uint64_t)40, len)), len > 40 ? "..." : "");
 
+    auto* pool = file_mgr->GetWorkerPool();
+
+    if ( pool )
+        // Lets asynchronous analyzers share a single copy of the data.
+        pool->BeginDelivery(data, len);
+
     for ( const auto& entry : analyzers ) {
         auto* a = entry.value;
 
@@ -336,7 +362,7 @@ void File::DeliverStream(const u_char* data, uint64_t len) {
         if ( ! a->GotStreamDelivery() ) {
             DBG_LOG(DBG_FILE_ANALYSIS, "skipping stream delivery to analyzer %s",
                     file_mgr->GetComponentName(a->Tag()).c_str());
-            int num_bof_chunks_behind = bof_buffer.chunks.size();
+            int num_bof_chunks_behind = bof_buffer.chunk_lens.size();
 
             if ( ! bof_was_full )
                 // We just added a chunk to the BOF buffer, don't count it
@@ -348,13 +374,13 @@ void File::DeliverStream(const u_char* data, uint64_t len) {
             // Catch this analyzer up with the BOF buffer.
             for ( int i = 0; i < num_bof_chunks_behind; ++i ) {
                 if ( ! a->Skipping() ) {
-                    if ( ! a->DeliverStream(bof_buffer.chunks[i]->Bytes(), bof_buffer.chunks[i]->Len()) ) {
+                    if ( ! a->DeliverStream(bof_buffer.data->Data() + bytes_delivered, bof_buffer.chunk_lens[i]) ) {
                         a->SetSkip(true);
                         analyzers.QueueRemove(a->Tag(), a->GetArgs());
                     }
                 }
 
-                bytes_delivered += bof_buffer.chunks[i]->Len();
+                bytes_delivered += bof_buffer.chunk_lens[i];
             }
 
             a->SetGotStreamDelivery();
@@ -370,6 +396,9 @@ void File::DeliverStream(const u_char* data, uint64_t len) {
         }
     }
 
+    if ( pool )
+        pool->EndDelivery();
+
     stream_offset += len;
     IncrementByteCount(len, seen_bytes_idx);
 }
@@ -5,6 +5,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "zeek/Tag.h"
 #include "zeek/WeirdState.h"
@@ -267,6 +268,12 @@ protected:
      */
     bool BufferBOF(const u_char* data, uint64_t len);
 
+    /**
+     * Returns a string for the script-layer \c bof_buffer field, which
+     * borrows the buffered bytes rather than copying them.
+     */
+    String* BOFBufferString() const;
+
     /**
      * Does metadata inference (e.g. mime type detection via file
      * magic signatures) using data in the BOF (beginning-of-file) buffer
@@ -330,15 +337,10 @@ protected:
                                             can be safely deleted. */
 
     struct BOF_Buffer {
-        BOF_Buffer() : full(false), size(0) {}
-        ~BOF_Buffer() {
-            for ( size_t i = 0; i < chunks.size(); ++i )
-                delete chunks[i];
-        }
-
-        bool full;
-        uint64_t size;
-        String::CVec chunks;
+        bool full = false;
+        uint64_t size = 0;
+        zeek::detail::StringBufferPtr data; /**< The buffered bytes, NUL-terminated. */
+        std::vector<uint64_t> chunk_lens;   /**< Lengths of the chunks the bytes were delivered in. */
     } bof_buffer; /**< Beginning of file buffer. */
 
     zeek::detail::WeirdStateMap weird_state;
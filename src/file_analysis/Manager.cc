@@ -6,6 +6,7 @@
 
 #include "zeek/CompHash.h"
 #include "zeek/Event.h"
+#include "zeek/NetVar.h"
 #include "zeek/UID.h"
 #include "zeek/analyzer/Manager.h"
 #include "zeek/digest.h"
@@ -34,6 +35,10 @@ Manager::~Manager() {
     for ( const auto& entry : id_map )
         delete entry.second;
 
+    // The analyzers' strands point into the pool, so it has to outlive all
+    // files, including those that handlers created during Terminate().
+    worker_pool.reset();
+
     delete magic_state;
     delete analyzer_hash;
 }
@@ -45,6 +50,10 @@ void Manager::InitPostScript() {
     t->Append(GetTagType());
     t->Append(BifType::Record::Files::AnalyzerArgs);
     analyzer_hash = new zeek::detail::CompositeHash(std::move(t));
+
+    if ( BifConst::Files::async_analysis_threads > 0 )
+        worker_pool = std::make_unique<detail::WorkerPool>(BifConst::Files::async_analysis_threads,
+                                                           BifConst::Files::async_analysis_max_bytes);
 }
 
 void Manager::InitMagic() {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -10,6 +11,7 @@
 #include "zeek/Tag.h"
 #include "zeek/file_analysis/Component.h"
 #include "zeek/file_analysis/FileTimer.h"
+#include "zeek/file_analysis/WorkerPool.h"
 #include "zeek/plugin/ComponentManager.h"
 
 namespace zeek {
@@ -372,6 +374,12 @@ public:
 
     zeek::detail::CompositeHash* GetAnalyzerHash() const { return analyzer_hash; }
 
+    /**
+     * Returns the pool of threads for asynchronous file analysis, or null
+     * if Files::async_analysis_threads is zero.
+     */
+    detail::WorkerPool* GetWorkerPool() const { return worker_pool.get(); }
+
 protected:
     friend class detail::FileTimer;
 
@@ -441,6 +449,7 @@ private:
     size_t max_files;
 
     zeek::detail::CompositeHash* analyzer_hash = nullptr;
+    std::unique_ptr<detail::WorkerPool> worker_pool;
 };
 
 /**
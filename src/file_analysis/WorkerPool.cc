@@ -0,0 +1,125 @@
+// See the file "COPYING" in the main distribution directory for copyright.
+
+#include "zeek/file_analysis/WorkerPool.h"
+
+#include <algorithm>
+
+#include "zeek/util.h"
+
+namespace zeek::file_analysis::detail {
+
+WorkerPool::WorkerPool(size_t num_threads, uint64_t arg_max_in_flight) : max_in_flight(arg_max_in_flight) {
+    for ( size_t i = 0; i < num_threads; ++i ) {
+        auto w = std::make_unique<Worker>();
+        std::string name = util::fmt("zk.files.%zu", i);
+        w->thread = std::thread([this, w = w.get(), name]() {
+            util::detail::set_thread_name(name.c_str());
+            Run(w);
+        });
+        workers.push_back(std::move(w));
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+
+    for ( auto& w : workers ) {
+        w->cond.notify_one();
+        w->thread.join();
+    }
+}
+
+std::unique_ptr<WorkerPool::Strand> WorkerPool::NewStrand() {
+    auto worker = next_worker;
+    next_worker = (next_worker + 1) % workers.size();
+    return std::unique_ptr<Strand>(new Strand(this, worker));
+}
+
+WorkerPool::Chunk WorkerPool::Share(const u_char* data, uint64_t len) {
+    if ( data != delivery_data || len != delivery_len )
+        return std::make_shared<const std::string>(reinterpret_cast<const char*>(data), len);
+
+    if ( ! delivery_chunk )
+        delivery_chunk = std::make_shared<const std::string>(reinterpret_cast<const char*>(data), len);
+
+    return delivery_chunk;
+}
+
+void WorkerPool::BeginDelivery(const u_char* data, uint64_t len) {
+    delivery_data = data;
+    delivery_len = len;
+    delivery_chunk.reset();
+}
+
+void WorkerPool::EndDelivery() { BeginDelivery(nullptr, 0); }
+
+WorkerPool::Stats WorkerPool::GetStats() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+
+void WorkerPool::Submit(Strand* strand, Chunk chunk, Work work) {
+    uint64_t len = chunk->size();
+    auto* w = workers[strand->worker].get();
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+
+        // A single chunk larger than the budget still goes through once
+        // nothing else is queued.
+        if ( in_flight > 0 && in_flight + len > max_in_flight ) {
+            ++stats.stalls;
+            done_cond.wait(lock, [&]() { return in_flight == 0 || in_flight + len <= max_in_flight; });
+        }
+
+        in_flight += len;
+        ++strand->pending;
+        ++stats.chunks;
+        stats.bytes += len;
+        stats.max_in_flight = std::max(stats.max_in_flight, in_flight);
+
+        w->tasks.push_back({strand, std::move(chunk), std::move(work)});
+    }
+
+    w->cond.notify_one();
+}
+
+void WorkerPool::Drain(Strand* strand) {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    if ( strand->pending == 0 )
+        return;
+
+    ++stats.drains;
+    done_cond.wait(lock, [strand]() { return strand->pending == 0; });
+}
+
+void WorkerPool::Run(Worker* w) {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while ( true ) {
+        w->cond.wait(lock, [&]() { return stopping || ! w->tasks.empty(); });
+
+        if ( w->tasks.empty() )
+            return;
+
+        Task t = std::move(w->tasks.front());
+        w->tasks.pop_front();
+        lock.unlock();
+
+        const auto& data = *t.chunk;
+        t.work(reinterpret_cast<const u_char*>(data.data()), data.size());
+        uint64_t len = data.size();
+        t.chunk.reset();
+
+        lock.lock();
+        in_flight -= len;
+        --t.strand->pending;
+        done_cond.notify_all();
+    }
+}
+
+} // namespace zeek::file_analysis::detail
@@ -0,0 +1,162 @@
+// See the file "COPYING" in the main distribution directory for copyright.
+
+#pragma once
+
+#include <sys/types.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zeek::file_analysis::detail {
+
+/**
+ * A fixed set of threads to which file analyzers can hand the CPU-heavy part
+ * of processing their stream data, such as feeding hash and entropy state.
+ * The pool exists only if Files::async_analysis_threads is non-zero.
+ *
+ * Each analyzer submits its work through a Strand, which is pinned to one
+ * worker thread so that the analyzer's chunks get processed in order.
+ * Analyzers drain their strand before they look at the resulting state on
+ * the main thread, so events get raised exactly as in synchronous mode.
+ *
+ * The number of bytes queued but not yet processed is bounded by
+ * Files::async_analysis_max_bytes: submitting beyond that blocks the main
+ * thread until the workers have caught up.
+ */
+class WorkerPool {
+public:
+    /**
+     * A reference-counted copy of a chunk of stream data, shared by all the
+     * analyzers of a file that submit it.
+     */
+    using Chunk = std::shared_ptr<const std::string>;
+
+    /**
+     * The operation a worker thread runs on a submitted chunk.
+     */
+    using Work = std::function<void(const u_char* data, uint64_t len)>;
+
+    struct Stats {
+        uint64_t chunks = 0;        //! Chunks submitted to worker threads.
+        uint64_t bytes = 0;         //! Bytes submitted to worker threads.
+        uint64_t stalls = 0;        //! Submissions that waited for the in-flight budget.
+        uint64_t drains = 0;        //! Times the main thread waited for a strand to finish.
+        uint64_t max_in_flight = 0; //! Maximum number of bytes queued at once.
+    };
+
+    /**
+     * The sequence of work submitted on behalf of one analyzer.
+     */
+    class Strand {
+    public:
+        /**
+         * Destructor. Waits for all outstanding work of the strand.
+         */
+        ~Strand() { Drain(); }
+
+        /**
+         * Queues \a work for running on \a chunk in a worker thread, after
+         * all work submitted to this strand earlier. May block if the pool's
+         * in-flight budget is exhausted.
+         */
+        void Submit(Chunk chunk, Work work) { pool->Submit(this, std::move(chunk), std::move(work)); }
+
+        /**
+         * Blocks until all work submitted to this strand has run.
+         */
+        void Drain() { pool->Drain(this); }
+
+    private:
+        friend class WorkerPool;
+
+        Strand(WorkerPool* arg_pool, size_t arg_worker) : pool(arg_pool), worker(arg_worker) {}
+
+        WorkerPool* pool;
+        size_t worker;
+        uint64_t pending = 0; // Guarded by the pool's mutex.
+    };
+
+    /**
+     * Constructor. Starts the worker threads.
+     * @param num_threads the number of worker threads.
+     * @param max_in_flight the number of queued bytes at which submissions
+     *        start to block.
+     */
+    WorkerPool(size_t num_threads, uint64_t max_in_flight);
+
+    /**
+     * Destructor. Lets the workers finish all queued work and joins them.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Returns a new strand, with strands being spread across the worker
+     * threads round-robin.
+     */
+    std::unique_ptr<Strand> NewStrand();
+
+    /**
+     * Returns a chunk holding a copy of the given data. While the data is
+     * the one announced by BeginDelivery(), all callers share a single copy.
+     */
+    Chunk Share(const u_char* data, uint64_t len);
+
+    /**
+     * Announces the data that's about to get delivered to all of a file's
+     * stream analyzers.
+     */
+    void BeginDelivery(const u_char* data, uint64_t len);
+
+    /**
+     * Ends the delivery announced by BeginDelivery().
+     */
+    void EndDelivery();
+
+    /**
+     * Returns statistics about the work handed to the pool so far.
+     */
+    Stats GetStats();
+
+private:
+    struct Task {
+        Strand* strand;
+        Chunk chunk;
+        Work work;
+    };
+
+    struct Worker {
+        std::thread thread;
+        std::condition_variable cond;
+        std::deque<Task> tasks;
+    };
+
+    void Submit(Strand* strand, Chunk chunk, Work work);
+    void Drain(Strand* strand);
+    void Run(Worker* w);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    size_t next_worker = 0;
+
+    std::mutex mtx;
+    std::condition_variable done_cond; // Signaled whenever a task finishes.
+    uint64_t in_flight = 0;
+    uint64_t max_in_flight;
+    bool stopping = false;
+    Stats stats;
+
+    // The delivery currently in progress, see BeginDelivery().
+    const u_char* delivery_data = nullptr;
+    uint64_t delivery_len = 0;
+    Chunk delivery_chunk;
+};
+
+} // namespace zeek::file_analysis::detail
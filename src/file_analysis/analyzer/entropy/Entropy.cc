@@ -12,11 +12,19 @@ namespace zeek::file_analysis::detail {
 
 Entropy::Entropy(RecordValPtr args, file_analysis::File* file)
     : file_analysis::Analyzer(file_mgr->GetComponentTag("ENTROPY"), std::move(args), file) {
-    entropy = new EntropyVal;
+    const auto& histogram_only = GetArgs()->GetField("entropy_histogram_only");
+    entropy = new EntropyVal(histogram_only && histogram_only->AsBool());
     fed = false;
+
+    if ( auto* pool = file_mgr->GetWorkerPool() )
+        strand = pool->NewStrand();
 }
 
-Entropy::~Entropy() { Unref(entropy); }
+Entropy::~Entropy() {
+    // Let pending work finish with the entropy state before releasing it.
+    strand.reset();
+    Unref(entropy);
+}
 
 file_analysis::Analyzer* Entropy::Instantiate(RecordValPtr args, file_analysis::File* file) {
     return new Entropy(std::move(args), file);
@@ -26,7 +34,14 @@ bool Entropy::DeliverStream(const u_char* data, uint64_t len) {
     if ( ! fed )
         fed = len > 0;
 
-    entropy->Feed(data, len);
+    if ( strand ) {
+        auto* e = entropy;
+        strand->Submit(file_mgr->GetWorkerPool()->Share(data, len),
+                       [e](const u_char* data, uint64_t len) { e->Feed(data, len); });
+    }
+    else
+        entropy->Feed(data, len);
+
     return true;
 }
 
@@ -44,6 +59,9 @@ void Entropy::Finalize() {
     if ( ! file_entropy )
         return;
 
+    if ( strand )
+        strand->Drain();
+
     double montepi, scc, ent, mean, chisq;
     montepi = scc = ent = mean = chisq = 0.0;
     entropy->Get(&ent, &chisq, &mean, &montepi, &scc);
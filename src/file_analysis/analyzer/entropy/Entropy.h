@@ -2,12 +2,14 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "zeek/OpaqueVal.h"
 #include "zeek/Val.h"
 #include "zeek/file_analysis/Analyzer.h"
 #include "zeek/file_analysis/File.h"
+#include "zeek/file_analysis/WorkerPool.h"
 #include "zeek/file_analysis/analyzer/entropy/events.bif.h"
 
 namespace zeek::file_analysis::detail {
@@ -73,6 +75,7 @@ protected:
 private:
     EntropyVal* entropy;
     bool fed;
+    std::unique_ptr<WorkerPool::Strand> strand; // Set if computing asynchronously.
 };
 
 } // namespace zeek::file_analysis::detail
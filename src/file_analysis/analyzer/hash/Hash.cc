@@ -2,7 +2,9 @@
 
 #include "zeek/file_analysis/analyzer/hash/Hash.h"
 
+#include <algorithm>
 #include <string>
+#include <unordered_map>
 
 #include "zeek/Event.h"
 #include "zeek/file_analysis/Manager.h"
@@ -10,6 +12,91 @@
 
 namespace zeek::file_analysis::detail {
 
+namespace {
+
+// Groups by the file they belong to. Entries go away with their last member.
+std::unordered_map<const file_analysis::File*, std::weak_ptr<HashGroup>> hash_groups;
+
+// How much data to feed to one hash before moving on to the next, sized to
+// stay in L1 cache.
+constexpr uint64_t feed_block_size = 16384;
+
+void feed_interleaved(const std::vector<HashVal*>& hashes, const u_char* data, uint64_t len) {
+    for ( uint64_t offset = 0; offset < len; offset += feed_block_size ) {
+        auto n = std::min(feed_block_size, len - offset);
+
+        for ( auto* hv : hashes )
+            hv->Feed(data + offset, n);
+    }
+}
+
+} // namespace
+
+HashGroup::HashGroup(file_analysis::File* arg_file) : file(arg_file) {
+    if ( auto* pool = file_mgr->GetWorkerPool() )
+        strand = pool->NewStrand();
+}
+
+std::shared_ptr<HashGroup> HashGroup::Join(file_analysis::File* file, Hash* h, HashVal* hv) {
+    auto& entry = hash_groups[file];
+    auto group = entry.lock();
+
+    if ( ! group ) {
+        group = std::shared_ptr<HashGroup>(new HashGroup(file));
+        entry = group;
+    }
+
+    group->members.push_back({h, hv, 0, false});
+    return group;
+}
+
+void HashGroup::Leave(Hash* h) {
+    // Work queued for the other members may use this member's hash too.
+    Drain();
+
+    members.erase(std::remove_if(members.begin(), members.end(), [h](const Member& m) { return m.analyzer == h; }),
+                  members.end());
+
+    if ( members.empty() )
+        hash_groups.erase(file);
+}
+
+void HashGroup::Deliver(Hash* h, const u_char* data, uint64_t len) {
+    auto it = std::find_if(members.begin(), members.end(), [h](const Member& m) { return m.analyzer == h; });
+
+    if ( it->prefed ) {
+        it->prefed = false;
+        return;
+    }
+
+    // Members that joined later catch up on the BOF buffer separately, so
+    // only those at the same offset are sure to get this chunk next.
+    std::vector<HashVal*> hashes;
+    auto offset = it->offset;
+
+    for ( auto& m : members ) {
+        if ( m.offset != offset || m.prefed || ! m.hash->IsValid() )
+            continue;
+
+        hashes.push_back(m.hash);
+        m.offset += len;
+        m.prefed = (m.analyzer != h);
+    }
+
+    if ( strand )
+        strand->Submit(file_mgr->GetWorkerPool()->Share(data, len),
+                       [hashes = std::move(hashes)](const u_char* data, uint64_t len) {
+                           feed_interleaved(hashes, data, len);
+                       });
+    else
+        feed_interleaved(hashes, data, len);
+}
+
+void HashGroup::Drain() {
+    if ( strand )
+        strand->Drain();
+}
+
 StringValPtr MD5::kind_val = make_intrusive<StringVal>("md5");
 StringValPtr SHA1::kind_val = make_intrusive<StringVal>("sha1");
 StringValPtr SHA256::kind_val = make_intrusive<StringVal>("sha256");
@@ -21,9 +108,13 @@ Hash::Hash(RecordValPtr args, file_analysis::File* file, HashVal* hv, StringValP
       fed(false),
       kind(std::move(arg_kind)) {
     hash->Init();
+    group = HashGroup::Join(file, this, hash);
 }
 
-Hash::~Hash() { Unref(hash); }
+Hash::~Hash() {
+    group->Leave(this);
+    Unref(hash);
+}
 
 bool Hash::DeliverStream(const u_char* data, uint64_t len) {
     if ( ! hash->IsValid() )
@@ -32,7 +123,7 @@ bool Hash::DeliverStream(const u_char* data, uint64_t len) {
     if ( ! fed )
         fed = len > 0;
 
-    hash->Feed(data, len);
+    group->Deliver(this, data, len);
     return true;
 }
 
@@ -50,6 +141,8 @@ void Hash::Finalize() {
     if ( ! file_hash )
         return;
 
+    group->Drain();
+
     event_mgr.Enqueue(file_hash, GetFile()->ToVal(), kind, hash->Get());
 }
 
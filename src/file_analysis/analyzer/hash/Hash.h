@@ -2,16 +2,69 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "zeek/OpaqueVal.h"
 #include "zeek/Val.h"
 #include "zeek/file_analysis/Analyzer.h"
 #include "zeek/file_analysis/File.h"
+#include "zeek/file_analysis/WorkerPool.h"
 #include "zeek/file_analysis/analyzer/hash/events.bif.h"
 
 namespace zeek::file_analysis::detail {
 
+class Hash;
+
+/**
+ * The hash analyzers attached to a single file. Rather than each analyzer
+ * making its own pass over a chunk of file data, the first one to receive
+ * the chunk feeds it to all of them block by block, so that the data is
+ * read from memory once while it's in cache. With asynchronous file
+ * analysis, that's also a single task for the worker threads.
+ */
+class HashGroup {
+public:
+    /**
+     * Returns the group of the given file's hash analyzers, adding \a h
+     * to it.
+     */
+    static std::shared_ptr<HashGroup> Join(file_analysis::File* file, Hash* h, HashVal* hv);
+
+    /**
+     * Removes \a h from the group, waiting for any asynchronous work on
+     * its hash state first.
+     */
+    void Leave(Hash* h);
+
+    /**
+     * Feeds a chunk of stream data to \a h's hash state, unless another
+     * member already did so, and to that of all other members that are
+     * at the same position in the stream.
+     */
+    void Deliver(Hash* h, const u_char* data, uint64_t len);
+
+    /**
+     * Waits until all data delivered so far has been fed to the hashes.
+     */
+    void Drain();
+
+private:
+    struct Member {
+        Hash* analyzer;
+        HashVal* hash;
+        uint64_t offset; // Number of bytes fed to the hash.
+        bool prefed;     // The next delivery was fed by another member.
+    };
+
+    explicit HashGroup(file_analysis::File* arg_file);
+
+    file_analysis::File* file;
+    std::vector<Member> members;
+    std::unique_ptr<WorkerPool::Strand> strand; // Set if hashing asynchronously.
+};
+
 /**
  * An analyzer to produce a hash of file contents.
  */
@@ -65,6 +118,7 @@ private:
     HashVal* hash;
     bool fed;
     StringValPtr kind;
+    std::shared_ptr<HashGroup> group;
 };
 
 /**
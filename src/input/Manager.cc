@@ -36,6 +36,7 @@ namespace zeek::input {
 struct InputHash {
     zeek::detail::hash_t valhash;
     zeek::detail::HashKey* idxkey;
+    bool removed = false; // reported through SendRemovedEntry()
     ~InputHash();
 };
 
@@ -165,7 +166,13 @@ Manager::TableStream::~TableStream() {
 
 Manager::AnalysisStream::AnalysisStream() : Manager::Stream::Stream(ANALYSIS_STREAM), file_id() {}
 
-Manager::Manager() : plugin::ComponentManager<input::Component>("Input", "Reader") {
+Manager::Manager()
+    : plugin::ComponentManager<input::Component>("Input", "Reader"),
+      rows_read_family(telemetry_mgr->CounterFamily("zeek", "input-reader-rows", {"stream"},
+                                                    "Total number of data rows parsed by the stream's reader.")),
+      parse_time_family(telemetry_mgr->CounterFamily("zeek", "input-reader-parse", {"stream"},
+                                                     "Total time the stream's reader spent reading and parsing rows.",
+                                                     "seconds")) {
     end_of_data = event_registry->Register("Input::end_of_data");
 }
 
@@ -1057,6 +1064,8 @@ int Manager::SendEntryTable(Stream* i, const Value* const* vals) {
         // seen before
         if ( stream->num_val_fields == 0 || h->valhash == valhash ) {
             // ok, exact duplicate, move entry to new dictionary and do nothing else.
+            // If the reader reported it removed earlier, it's back now.
+            h->removed = false;
             stream->lastDict->Remove(idxhash);
             stream->currDict->Insert(idxhash, h);
             delete idxhash;
@@ -1122,6 +1131,7 @@ int Manager::SendEntryTable(Stream* i, const Value* const* vals) {
 
                 else {
                     // keep old one
+                    h->removed = false;
                     stream->currDict->Insert(idxhash, h);
                     delete idxhash;
                     return stream->num_val_fields + stream->num_idx_fields;
@@ -1206,6 +1216,69 @@ int Manager::SendEntryTable(Stream* i, const Value* const* vals) {
     return stream->num_val_fields + stream->num_idx_fields;
 }
 
+void Manager::SendRemovedEntry(ReaderFrontend* reader, Value** vals) {
+    Stream* i = FindStream(reader);
+    if ( i == nullptr ) {
+        reporter->InternalWarning("Unknown reader %s in SendRemovedEntry", reader->Name());
+        return;
+    }
+
+    int readFields = 0;
+
+    if ( i->stream_type == TABLE_STREAM ) {
+        auto* stream = static_cast<TableStream*>(i);
+        readFields = stream->num_idx_fields + stream->num_val_fields;
+
+        // Just mark the entry; EndCurrentDelta() removes it unless the
+        // reader sent it again in the meantime.
+        if ( zeek::detail::HashKey* idxhash = HashValues(stream->num_idx_fields, vals) ) {
+            if ( InputHash* h = stream->lastDict->Lookup(idxhash) )
+                h->removed = true;
+
+            delete idxhash;
+        }
+    }
+
+    else if ( i->stream_type == EVENT_STREAM ) {
+        auto type = BifType::Enum::Input::Event->GetEnumVal(BifEnum::Input::EVENT_REMOVED);
+        readFields = SendEventStreamEvent(i, type.release(), vals);
+    }
+
+    else if ( i->stream_type == ANALYSIS_STREAM )
+        readFields = 1;
+
+    else
+        assert(false);
+
+    Value::delete_value_ptr_array(vals, readFields);
+}
+
+void Manager::EndCurrentDelta(ReaderFrontend* reader) {
+    Stream* i = FindStream(reader);
+
+    if ( i == nullptr ) {
+        reporter->InternalWarning("Unknown reader %s in EndCurrentDelta", reader->Name());
+        return;
+    }
+
+    if ( i->stream_type == TABLE_STREAM ) {
+        auto* stream = static_cast<TableStream*>(i);
+
+        // Carry over everything the reader didn't touch. What remains in
+        // lastDict afterwards is what it reported as removed, which
+        // EndCurrentSend() then deletes as usual.
+        for ( auto it = stream->lastDict->begin_robust(); it != stream->lastDict->end_robust(); ++it ) {
+            if ( it->value->removed )
+                continue;
+
+            auto key = it->GetHashKey();
+            stream->currDict->Insert(key.get(), stream->lastDict->RemoveEntry(key.get()));
+        }
+    }
+
+    EndCurrentSend(reader);
+}
+
 void Manager::EndCurrentSend(ReaderFrontend* reader) {
     Stream* i = FindStream(reader);
 
@@ -1299,6 +1372,19 @@ void Manager::SendEndOfData(ReaderFrontend* reader) {
     SendEndOfData(i);
 }
 
+void Manager::ReadStats(ReaderFrontend* reader, uint64_t rows, double seconds) {
+    Stream* i = FindStream(reader);
+
+    if ( i == nullptr ) {
+        reporter->InternalWarning("Unknown reader %s in ReadStats", reader->Name());
+        return;
+    }
+
+    std::initializer_list<telemetry::LabelView> labels{{"stream", i->name}};
+    rows_read_family->GetOrAdd(labels)->Inc(static_cast<double>(rows));
+    parse_time_family->GetOrAdd(labels)->Inc(seconds);
+}
+
 void Manager::SendEndOfData(const Stream* i) {
 #ifdef DEBUG
     DBG_LOG(DBG_INPUT, "SendEndOfData for stream %s", i->name.c_str());
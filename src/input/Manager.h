@@ -10,6 +10,7 @@
 #include "zeek/Tag.h"
 #include "zeek/input/Component.h"
 #include "zeek/plugin/ComponentManager.h"
+#include "zeek/telemetry/Manager.h"
 #include "zeek/threading/SerialTypes.h"
 
 namespace zeek {
@@ -122,9 +123,12 @@ protected:
     friend class ClearMessage;
     friend class SendEntryMessage;
     friend class EndCurrentSendMessage;
+    friend class SendRemovedEntryMessage;
+    friend class EndCurrentDeltaMessage;
     friend class ReaderClosedMessage;
     friend class DisableMessage;
     friend class EndOfDataMessage;
+    friend class ReadStatsMessage;
     friend class ReaderErrorMessage;
 
     // For readers to write to input stream in direct mode (reporting
@@ -143,6 +147,15 @@ protected:
     void SendEntry(ReaderFrontend* reader, threading::Value** vals);
     void EndCurrentSend(ReaderFrontend* reader);
 
+    // Variants of the above for readers that send only what changed
+    // since their previous round.
+    void SendRemovedEntry(ReaderFrontend* reader, threading::Value** vals);
+    void EndCurrentDelta(ReaderFrontend* reader);
+
+    // Adds the number of rows a reader parsed during an update, and the
+    // time that took, to the stream's telemetry.
+    void ReadStats(ReaderFrontend* reader, uint64_t rows, double seconds);
+
     // Instantiates a new ReaderBackend of the given type (note that
     // doing so creates a new thread!).
     ReaderBackend* CreateBackend(ReaderFrontend* frontend, EnumVal* tag);
@@ -261,6 +274,9 @@ private:
     std::map<ReaderFrontend*, Stream*> readers;
 
     EventHandlerPtr end_of_data;
+
+    std::shared_ptr<telemetry::CounterFamily> rows_read_family;
+    std::shared_ptr<telemetry::CounterFamily> parse_time_family;
 };
 
 } // namespace input
@@ -94,6 +94,48 @@ public:
 private:
 };
 
+class SendRemovedEntryMessage final : public threading::OutputMessage<ReaderFrontend> {
+public:
+    SendRemovedEntryMessage(ReaderFrontend* reader, Value** val)
+        : threading::OutputMessage<ReaderFrontend>("SendRemovedEntry", reader), val(val) {}
+
+    bool Process() override {
+        input_mgr->SendRemovedEntry(Object(), val);
+        return true;
+    }
+
+private:
+    Value** val;
+};
+
+class EndCurrentDeltaMessage final : public threading::OutputMessage<ReaderFrontend> {
+public:
+    EndCurrentDeltaMessage(ReaderFrontend* reader)
+        : threading::OutputMessage<ReaderFrontend>("EndCurrentDelta", reader) {}
+
+    bool Process() override {
+        input_mgr->EndCurrentDelta(Object());
+        return true;
+    }
+
+private:
+};
+
+class ReadStatsMessage final : public threading::OutputMessage<ReaderFrontend> {
+public:
+    ReadStatsMessage(ReaderFrontend* reader, uint64_t rows, double seconds)
+        : threading::OutputMessage<ReaderFrontend>("ReadStats", reader), rows(rows), seconds(seconds) {}
+
+    bool Process() override {
+        input_mgr->ReadStats(Object(), rows, seconds);
+        return true;
+    }
+
+private:
+    uint64_t rows;
+    double seconds;
+};
+
 class EndOfDataMessage final : public threading::OutputMessage<ReaderFrontend> {
 public:
     EndOfDataMessage(ReaderFrontend* reader) : threading::OutputMessage<ReaderFrontend>("EndOfData", reader) {}
@@ -172,6 +214,14 @@ void ReaderBackend::EndOfData() { SendOut(new EndOfDataMessage(frontend)); }
 
 void ReaderBackend::SendEntry(Value** vals) { SendOut(new SendEntryMessage(frontend, vals)); }
 
+void ReaderBackend::SendRemovedEntry(Value** vals) { SendOut(new SendRemovedEntryMessage(frontend, vals)); }
+
+void ReaderBackend::EndCurrentDelta() { SendOut(new EndCurrentDeltaMessage(frontend)); }
+
+void ReaderBackend::ReadStats(uint64_t rows, double seconds) {
+    SendOut(new ReadStatsMessage(frontend, rows, seconds));
+}
+
 bool ReaderBackend::Init(const int arg_num_fields, const threading::Field* const* arg_fields) {
     if ( Failed() )
         return true;
@@ -246,6 +296,11 @@ bool ReaderBackend::OnHeartbeat(double network_time, double current_time) {
 }
 
 void ReaderBackend::Info(const char* msg) {
+    if ( auto* h = HelperScope::Current(this) ) {
+        h->Collect(HelperScope::INFO, msg);
+        return;
+    }
+
     SendOut(new ReaderErrorMessage(frontend, ReaderErrorMessage::INFO, msg));
     MsgThread::Info(msg);
 }
@@ -264,6 +319,11 @@ void ReaderBackend::FailWarn(bool is_error, const char* msg, bool suppress_futur
     }
 }
 void ReaderBackend::Warning(const char* msg) {
+    if ( auto* h = HelperScope::Current(this) ) {
+        h->Collect(HelperScope::WARNING, msg);
+        return;
+    }
+
     if ( suppress_warnings )
         return;
 
@@ -272,6 +332,11 @@ void ReaderBackend::Warning(const char* msg) {
 }
 
 void ReaderBackend::Error(const char* msg) {
+    if ( auto* h = HelperScope::Current(this) ) {
+        h->Collect(HelperScope::ERROR, msg);
+        return;
+    }
+
     SendOut(new ReaderErrorMessage(frontend, ReaderErrorMessage::ERROR, msg));
     MsgThread::Error(msg);
 
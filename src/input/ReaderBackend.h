@@ -352,6 +352,37 @@ protected:
      */
     void EndCurrentSend();
 
+    /**
+     * Method allowing a reader to tell the manager, in tracking mode,
+     * that an entry it sent during a previous round is no longer present
+     * in the input source. Only meaningful for a round concluded by
+     * EndCurrentDelta().
+     *
+     * If the stream is an event stream, a removed event is raised.
+     *
+     * @param val Array of threading::Values expected by the stream. The
+     * array must have exactly NumEntries() elements.
+     */
+    void SendRemovedEntry(threading::Value** vals);
+
+    /**
+     * Like EndCurrentSend(), but for a round in which the reader sent
+     * only the changes since the previous one: entries that were neither
+     * sent again nor reported through SendRemovedEntry() are kept.
+     */
+    void EndCurrentDelta();
+
+    /**
+     * Method allowing a reader to tell the manager how many rows it parsed
+     * during an update, and how long that took. The manager accumulates
+     * these per stream in its telemetry metrics.
+     *
+     * @param rows The number of data rows parsed, including invalid ones.
+     *
+     * @param seconds The time spent reading, parsing and sending them.
+     */
+    void ReadStats(uint64_t rows, double seconds);
+
 private:
     // Frontend that instantiated us. This object must not be accessed
     // from this class, it's running in a different thread!
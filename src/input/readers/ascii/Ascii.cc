@@ -2,11 +2,19 @@
 
 #include "zeek/input/readers/ascii/Ascii.h"
 
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "zeek/input/readers/ascii/ascii.bif.h"
 #include "zeek/threading/SerialTypes.h"
@@ -17,6 +25,12 @@ using zeek::threading::Value;
 
 namespace zeek::input::reader::detail {
 
+// Number of lines that ReadSnapshot() parses before handing them over.
+static constexpr size_t PARSE_BATCH_SIZE = 65536;
+
+// Upper bound for a stream's parse_threads option.
+static constexpr long MAX_PARSE_THREADS = 64;
+
 FieldMapping::FieldMapping(const string& arg_name, const TypeTag& arg_type, int arg_position)
     : name(arg_name), type(arg_type), subtype(TYPE_ERROR) {
     position = arg_position;
@@ -59,6 +73,8 @@ Ascii::Ascii(ReaderFrontend* frontend) : ReaderBackend(frontend) {
     ino = 0;
     fail_on_file_problem = false;
     fail_on_invalid_lines = false;
+    incremental_reread = false;
+    parse_threads = 0;
 }
 
 void Ascii::DoClose() { read_location.reset(); }
@@ -79,6 +95,13 @@ bool Ascii::DoInit(const ReaderInfo& info, int num_fields, const Field* const* f
 
     fail_on_invalid_lines = BifConst::InputAscii::fail_on_invalid_lines;
     fail_on_file_problem = BifConst::InputAscii::fail_on_file_problem;
+    incremental_reread = BifConst::InputAscii::incremental_reread;
+
+    // More parsing threads than the hardware runs at once don't help, so
+    // the global default gets capped to that. A stream's own value is taken
+    // as given, up to MAX_PARSE_THREADS.
+    const int max_parse_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+    parse_threads = static_cast<int>(std::min<zeek_uint_t>(BifConst::InputAscii::parse_threads, max_parse_threads));
 
     path_prefix.assign((const char*)BifConst::InputAscii::path_prefix->Bytes(),
                        BifConst::InputAscii::path_prefix->Len());
@@ -102,6 +125,20 @@ bool Ascii::DoInit(const ReaderInfo& info, int num_fields, const Field* const* f
 
         else if ( strcmp(k, "fail_on_file_problem") == 0 )
             fail_on_file_problem = (strncmp(v, "T", 1) == 0);
+
+        else if ( strcmp(k, "incremental_reread") == 0 )
+            incremental_reread = (strncmp(v, "T", 1) == 0);
+
+        else if ( strcmp(k, "parse_threads") == 0 ) {
+            char* end;
+            errno = 0;
+            long n = strtol(v, &end, 10);
+
+            if ( errno != 0 || end == v || *end || n <= 0 )
+                Warning(Fmt("Invalid parse_threads value '%s'. Ignoring.", v));
+            else
+                parse_threads = static_cast<int>(std::min<long>(n, MAX_PARSE_THREADS));
+        }
     }
 
     if ( separator.size() != 1 )
@@ -314,101 +351,416 @@ bool Ascii::DoUpdate() {
         default: assert(false);
     }
 
+    if ( (incremental_reread || parse_threads > 1) && Info().mode != MODE_STREAM )
+        return ReadSnapshot();
+
     string line;
+    uint64_t rows = 0;
+    auto start = std::chrono::steady_clock::now();
 
     file.sync();
 
     while ( GetLine(line) ) {
-        // split on tabs
-        bool error = false;
-        auto stringfields = util::split(line, separator[0]);
-
-        // This needs to be a signed value or the comparisons below will fail.
-        int pos = static_cast<int>(stringfields.size() - 1);
-
-        Value** fields = new Value*[NumFields()];
-
-        int fpos = 0;
-        for ( const auto& fit : columnMap ) {
-            if ( ! fit.present ) {
-                // add non-present field
-                fields[fpos] = new Value(fit.type, false);
-                if ( read_location )
-                    fields[fpos]->SetFileLineNumber(read_location->first_line);
-                fpos++;
+        ++rows;
+        bool fatal = false;
+        Value** fields = ParseLine(line, read_location ? read_location->first_line : 0, fatal);
+
+        if ( fatal )
+            return false;
+
+        if ( ! fields )
+            continue;
+
+        if ( Info().mode == MODE_STREAM )
+            Put(fields);
+        else
+            SendEntry(fields);
+    }
+
+    if ( rows > 0 || Info().mode != MODE_STREAM )
+        ReadStats(rows, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    if ( Info().mode != MODE_STREAM )
+        EndCurrentSend();
+
+    return true;
+}
+
+Value** Ascii::ParseLine(const string& line, int line_number, bool& fatal) {
+    // split on tabs
+    auto stringfields = util::split(line, separator[0]);
+
+    // This needs to be a signed value or the comparisons below will fail.
+    int pos = static_cast<int>(stringfields.size() - 1);
+
+    Value** fields = new Value*[NumFields()];
+
+    int fpos = 0;
+    for ( const auto& fit : columnMap ) {
+        if ( ! fit.present ) {
+            // add non-present field
+            fields[fpos] = new Value(fit.type, false);
+            fields[fpos]->SetFileLineNumber(line_number);
+            fpos++;
+            continue;
+        }
+
+        assert(fit.position >= 0);
+
+        if ( fit.position > pos || fit.secondary_position > pos ) {
+            FailWarn(fail_on_invalid_lines,
+                     Fmt("Not enough fields in line '%s' of %s. Found "
+                         "%d fields, want positions %d and %d",
+                         line.c_str(), fname.c_str(), pos, fit.position, fit.secondary_position));
+
+            fatal = fail_on_invalid_lines;
+            break;
+        }
+
+        Value* val = formatter->ParseValue(stringfields[fit.position], fit.name, fit.type, fit.subtype);
+        if ( ! val ) {
+            Warning(Fmt("Could not convert line '%s' of %s to Val. Ignoring line.", line.c_str(), fname.c_str()));
+            break;
+        }
+
+        val->SetFileLineNumber(line_number);
+
+        if ( fit.secondary_position != -1 ) {
+            // we have a port definition :)
+            assert(val->type == TYPE_PORT);
+            //	Error(Fmt("Got type %d != PORT with secondary position!", val->type));
+
+            val->val.port_val.proto = formatter->ParseProto(stringfields[fit.secondary_position]);
+        }
+
+        fields[fpos] = val;
+
+        fpos++;
+    }
+
+    if ( fpos != NumFields() ) {
+        // Encountered an error, ignoring line. But first, delete all
+        // successfully read fields and the array structure.
+        for ( int i = 0; i < fpos; i++ )
+            delete fields[i];
+
+        delete[] fields;
+        return nullptr;
+    }
+
+    return fields;
+}
+
+bool Ascii::ReadSnapshot() {
+    auto start = std::chrono::steady_clock::now();
+    int fd = open(fname.c_str(), O_RDONLY);
+
+    if ( fd < 0 ) {
+        FailWarn(fail_on_file_problem, Fmt("Could not read %s", fname.c_str()), true);
+        return ! fail_on_file_problem;
+    }
+
+    // We copy the file rather than mapping it, as in REREAD mode it may
+    // get truncated or rewritten while we work on it, and accessing a
+    // mapping beyond the new end of the file faults. A file that changes
+    // underneath us at worst yields an inconsistent copy, just as with
+    // reading it line by line.
+    std::string buffer;
+    struct stat sb;
+
+    if ( fstat(fd, &sb) == 0 && sb.st_size > 0 )
+        // One more byte so that the read hitting the end of an unchanged
+        // file doesn't have to grow the buffer.
+        buffer.resize(static_cast<size_t>(sb.st_size) + 1);
+
+    size_t size = 0;
+
+    while ( true ) {
+        if ( size == buffer.size() )
+            buffer.resize(std::max<size_t>(2 * size, 65536));
+
+        ssize_t n = read(fd, &buffer[size], buffer.size() - size);
+
+        if ( n < 0 && errno == EINTR )
+            continue;
+
+        if ( n < 0 ) {
+            int err = errno;
+            close(fd);
+            FailWarn(fail_on_file_problem, Fmt("Could not read %s: %s", fname.c_str(), strerror(err)), true);
+            return ! fail_on_file_problem;
+        }
+
+        if ( n == 0 )
+            break;
+
+        size += static_cast<size_t>(n);
+    }
+
+    close(fd);
+
+    const char* data = buffer.data();
+
+    // Collect the data lines, filtering them the same way as GetLine().
+    // The first line that GetLine() would return is the header.
+    std::vector<SnapshotLine> lines;
+    std::unordered_map<size_t, std::string_view> current;
+    std::hash<std::string_view> hasher;
+    bool seen_header = false;
+    bool collision = false;
+    int line_number = 0;
+
+    for ( size_t i = 0; i < size; ) {
+        const char* nl = static_cast<const char*>(memchr(data + i, '\n', size - i));
+        size_t end = nl ? nl - data : size;
+        std::string_view l(data + i, end - i);
+        i = end + 1;
+        ++line_number;
+
+        if ( l.empty() )
+            continue;
+
+        if ( l.back() == '\r' )
+            l.remove_suffix(1);
+
+        if ( ! l.empty() && l[0] == '#' ) {
+            if ( l.size() > 8 && l.compare(0, 7, "#fields") == 0 && l[7] == separator[0] )
+                l.remove_prefix(8);
+            else
                 continue;
-            }
+        }
 
-            assert(fit.position >= 0);
+        if ( ! seen_header ) {
+            seen_header = true;
+            continue;
+        }
 
-            if ( fit.position > pos || fit.secondary_position > pos ) {
-                FailWarn(fail_on_invalid_lines,
-                         Fmt("Not enough fields in line '%s' of %s. Found "
-                             "%d fields, want positions %d and %d",
-                             line.c_str(), fname.c_str(), pos, fit.position, fit.secondary_position));
+        size_t h = 0;
 
-                if ( fail_on_invalid_lines ) {
-                    for ( int i = 0; i < fpos; i++ )
-                        delete fields[i];
+        if ( incremental_reread ) {
+            h = hasher(l);
+            auto [it, inserted] = current.try_emplace(h, l);
 
-                    delete[] fields;
+            if ( ! inserted && it->second != l )
+                collision = true;
+        }
 
-                    return false;
-                }
-                else {
-                    error = true;
-                    break;
-                }
-            }
+        lines.push_back({l, h, line_number});
+    }
+
+    // Without a previous read under the same header, or if two distinct
+    // lines hash the same, we fall back to sending everything.
+    bool delta = incremental_reread && have_previous_lines && headerline == previous_headerline && ! collision;
+
+    std::vector<size_t> removed;
 
-            Value* val = formatter->ParseValue(stringfields[fit.position], fit.name, fit.type, fit.subtype);
-            if ( ! val ) {
-                Warning(Fmt("Could not convert line '%s' of %s to Val. Ignoring line.", line.c_str(), fname.c_str()));
-                error = true;
+    if ( delta ) {
+        for ( const auto& [h, text] : previous_lines ) {
+            auto it = current.find(h);
+
+            if ( it == current.end() )
+                removed.push_back(h);
+
+            else if ( it->second != text ) {
+                delta = false;
                 break;
             }
+        }
+    }
+
+    if ( ! delta ) {
+        previous_lines.clear();
+        removed.clear();
+    }
+
+    if ( read_location ) {
+        read_location->first_line = 0;
+        read_location->last_line = 0;
+    }
+
+    // Removals go first so that a changed line for an existing index
+    // turns into an update of that entry.
+    for ( auto h : removed ) {
+        auto it = previous_lines.find(h);
+        bool fatal = false;
+
+        if ( Value** fields = ParseLine(it->second, 0, fatal) )
+            SendRemovedEntry(fields);
+
+        previous_lines.erase(it);
+    }
+
+    std::vector<const SnapshotLine*> todo;
+    todo.reserve(lines.size());
+
+    for ( const auto& l : lines ) {
+        if ( delta && previous_lines.count(l.hash) )
+            // Unchanged, or a duplicate of a line we already sent.
+            continue;
+
+        todo.push_back(&l);
+    }
+
+    bool ok = SendSnapshotLines(todo);
+
+    if ( ! ok ) {
+        previous_lines.clear();
+        have_previous_lines = false;
+        return false;
+    }
+
+    ReadStats(removed.size() + todo.size(),
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    if ( delta )
+        EndCurrentDelta();
+    else
+        EndCurrentSend();
+
+    have_previous_lines = incremental_reread;
+    previous_headerline = headerline;
+
+    return true;
+}
+
+bool Ascii::SendSnapshotLines(const std::vector<const SnapshotLine*>& lines) {
+    size_t nthreads = std::max(parse_threads, 1);
+    std::vector<Value**> parsed;
+    std::vector<char> fatal;
+    std::vector<std::vector<HelperScope::Message>> messages(nthreads);
+
+    // The batch being parsed. The helpers start on it once batch gets
+    // bumped, and the last one to finish its slice signals done_cond.
+    std::mutex mtx;
+    std::condition_variable batch_cond;
+    std::condition_variable done_cond;
+    uint64_t batch = 0;
+    size_t first = 0;
+    size_t n = 0;
+    size_t busy = 0;
+    bool stopping = false;
+
+    // Each thread parses one contiguous slice of the batch, holding back
+    // its messages so that we can report them in line order.
+    auto parse_slice = [&](HelperScope& scope, size_t slice) {
+        size_t begin = n * slice / nthreads;
+        size_t end = n * (slice + 1) / nthreads;
+
+        for ( size_t i = begin; i < end; ++i ) {
+            const auto* l = lines[first + i];
+            bool f = false;
+            scope.SetTag(i);
+            parsed[i] = ParseLine(std::string(l->text), l->line_number, f);
+            fatal[i] = f;
+        }
+
+        messages[slice] = scope.TakeMessages();
+    };
 
-            if ( read_location )
-                val->SetFileLineNumber(read_location->first_line);
+    // The helpers stay around for all of the read's batches.
+    auto run_helper = [&](size_t slice) {
+        HelperScope scope(this);
+        uint64_t done = 0;
 
-            if ( fit.secondary_position != -1 ) {
-                // we have a port definition :)
-                assert(val->type == TYPE_PORT);
-                //	Error(Fmt("Got type %d != PORT with secondary position!", val->type));
+        while ( true ) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                batch_cond.wait(lock, [&] { return stopping || batch != done; });
 
-                val->val.port_val.proto = formatter->ParseProto(stringfields[fit.secondary_position]);
+                if ( stopping )
+                    return;
+
+                done = batch;
             }
 
-            fields[fpos] = val;
+            parse_slice(scope, slice);
 
-            fpos++;
+            std::lock_guard<std::mutex> lock(mtx);
+
+            if ( --busy == 0 )
+                done_cond.notify_one();
         }
+    };
 
-        if ( error ) {
-            // Encountered non-fatal error, ignoring line. But
-            // first, delete all successfully read fields and the
-            // array structure.
+    std::vector<std::thread> helpers;
 
-            for ( int i = 0; i < fpos; i++ )
-                delete fields[i];
+    for ( size_t t = 1; t < nthreads; ++t )
+        helpers.emplace_back(run_helper, t);
 
-            delete[] fields;
-            continue;
+    bool ok = true;
+
+    for ( size_t next = 0; ok && next < lines.size(); next += PARSE_BATCH_SIZE ) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            first = next;
+            n = std::min(PARSE_BATCH_SIZE, lines.size() - first);
+            parsed.assign(n, nullptr);
+            fatal.assign(n, 0);
+            busy = nthreads - 1;
+            ++batch;
         }
 
-        // printf("fpos: %d, second.num_fields: %d\n", fpos, (*it).second.num_fields);
-        assert(fpos == NumFields());
+        batch_cond.notify_all();
 
-        if ( Info().mode == MODE_STREAM )
-            Put(fields);
-        else
-            SendEntry(fields);
+        {
+            // Our own scope must be gone before we report the messages.
+            HelperScope scope(this);
+            parse_slice(scope, 0);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done_cond.wait(lock, [&] { return busy == 0; });
+        }
+
+        // Now hand over the batch in file order.
+        size_t slice = 0;
+        size_t next_msg = 0;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            for ( ; slice < nthreads; ++slice, next_msg = 0 ) {
+                if ( next_msg < messages[slice].size() )
+                    break;
+            }
+
+            while ( slice < nthreads && next_msg < messages[slice].size() && messages[slice][next_msg].tag == i ) {
+                if ( read_location ) {
+                    read_location->first_line = lines[first + i]->line_number;
+                    read_location->last_line = lines[first + i]->line_number;
+                }
+
+                Report(messages[slice][next_msg++]);
+            }
+
+            if ( fatal[i] ) {
+                for ( size_t j = i + 1; j < n; ++j )
+                    if ( parsed[j] )
+                        Value::delete_value_ptr_array(parsed[j], NumFields());
+
+                ok = false;
+                break;
+            }
+
+            if ( parsed[i] ) {
+                SendEntry(parsed[i]);
+
+                if ( incremental_reread )
+                    previous_lines.try_emplace(lines[first + i]->hash, lines[first + i]->text);
+            }
+        }
     }
 
-    if ( Info().mode != MODE_STREAM )
-        EndCurrentSend();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
 
-    return true;
+    batch_cond.notify_all();
+
+    for ( auto& t : helpers )
+        t.join();
+
+    return ok;
 }
 
 bool Ascii::DoHeartbeat(double network_time, double current_time) {
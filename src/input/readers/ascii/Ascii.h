@@ -6,6 +6,8 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "zeek/Obj.h"
@@ -63,6 +65,27 @@ private:
     bool GetLine(std::string& str);
     bool OpenFile();
 
+    // Parses a data line into the stream's fields. Returns null if the
+    // line is invalid; fatal gets set if reading has to abort. Safe to
+    // call from helper threads covered by a HelperScope.
+    threading::Value** ParseLine(const std::string& line, int line_number, bool& fatal);
+
+    // A data line of a file snapshot.
+    struct SnapshotLine {
+        std::string_view text;
+        size_t hash; // only set for incremental_reread
+        int line_number;
+    };
+
+    // Reads the file into memory as a whole. Used for parse_threads
+    // and incremental_reread, for which it sends only the lines that
+    // changed since the previous read.
+    bool ReadSnapshot();
+
+    // Parses the lines, spreading the work over parse_threads threads,
+    // and sends them in order.
+    bool SendSnapshotLines(const std::vector<const SnapshotLine*>& lines);
+
     std::ifstream file;
     time_t mtime;
     ino_t ino;
@@ -85,8 +108,17 @@ private:
     std::string unset_field;
     bool fail_on_invalid_lines;
     bool fail_on_file_problem;
+    bool incremental_reread;
+    int parse_threads;
     std::string path_prefix;
 
+    // For incremental_reread, the lines of the previous read that parsed
+    // successfully, keyed by the hash of their content, along with the
+    // header they were parsed under.
+    std::unordered_map<size_t, std::string> previous_lines;
+    std::string previous_headerline;
+    bool have_previous_lines = false;
+
     std::unique_ptr<threading::Formatter> formatter;
 
     // zeek::detail::Location doesn't have a destructor because it's constexpr, so we have to
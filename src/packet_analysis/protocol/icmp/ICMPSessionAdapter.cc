@@ -22,8 +22,11 @@ void ICMPSessionAdapter::AddExtraAnalyzers(Connection* conn) {
 }
 
 void ICMPSessionAdapter::UpdateConnVal(zeek::RecordVal* conn_val) {
-    const auto& orig_endp = conn_val->GetField("orig");
-    const auto& resp_endp = conn_val->GetField("resp");
+    static const auto& conn_type = zeek::id::find_type<zeek::RecordType>("connection");
+    static const int origidx = conn_type->FieldOffset("orig");
+    static const int respidx = conn_type->FieldOffset("resp");
+    const auto& orig_endp = conn_val->GetField(origidx);
+    const auto& resp_endp = conn_val->GetField(respidx);
 
     UpdateEndpointVal(orig_endp, true);
     UpdateEndpointVal(resp_endp, false);
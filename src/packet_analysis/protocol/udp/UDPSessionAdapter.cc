@@ -23,8 +23,11 @@ void UDPSessionAdapter::AddExtraAnalyzers(Connection* conn) {
 }
 
 void UDPSessionAdapter::UpdateConnVal(RecordVal* conn_val) {
-    auto orig_endp = conn_val->GetField("orig");
-    auto resp_endp = conn_val->GetField("resp");
+    static const auto& conn_type = zeek::id::find_type<zeek::RecordType>("connection");
+    static const int origidx = conn_type->FieldOffset("orig");
+    static const int respidx = conn_type->FieldOffset("resp");
+    auto orig_endp = conn_val->GetField(origidx);
+    auto resp_endp = conn_val->GetField(respidx);
 
     UpdateEndpointVal(orig_endp, true);
     UpdateEndpointVal(resp_endp, false);
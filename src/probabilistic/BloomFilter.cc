@@ -171,7 +171,8 @@ BasicBloomFilter::BasicBloomFilter(const detail::Hasher* hasher, size_t cells) :
 BasicBloomFilter::~BasicBloomFilter() { delete bits; }
 
 void BasicBloomFilter::Add(const zeek::detail::HashKey* key) {
-    detail::Hasher::digest_vector h = hasher->Hash(key);
+    hasher->Hash(key, &digests);
+    const auto& h = digests;
 
     for ( size_t i = 0; i < h.size(); ++i )
         bits->Set(h[i] % bits->Size());
@@ -183,7 +184,8 @@ bool BasicBloomFilter::Decrement(const zeek::detail::HashKey* key) {
 }
 
 size_t BasicBloomFilter::Count(const zeek::detail::HashKey* key) const {
-    detail::Hasher::digest_vector h = hasher->Hash(key);
+    hasher->Hash(key, &digests);
+    const auto& h = digests;
 
     for ( size_t i = 0; i < h.size(); ++i ) {
         if ( ! (*bits)[h[i] % bits->Size()] )
@@ -274,7 +276,8 @@ std::string CountingBloomFilter::InternalState() const { return util::fmt("%" PR
 
 // TODO: Use partitioning in add/count to allow for reusing CMS bounds.
 void CountingBloomFilter::Add(const zeek::detail::HashKey* key) {
-    detail::Hasher::digest_vector h = hasher->Hash(key);
+    hasher->Hash(key, &digests);
+    const auto& h = digests;
 
     for ( size_t i = 0; i < h.size(); ++i )
         cells->Increment(h[i] % cells->Size());
@@ -285,7 +288,8 @@ bool CountingBloomFilter::Decrement(const zeek::detail::HashKey* key) {
     if ( Count(key) == 0 )
         return false;
 
-    detail::Hasher::digest_vector h = hasher->Hash(key);
+    hasher->Hash(key, &digests);
+    const auto& h = digests;
 
     for ( size_t i = 0; i < h.size(); ++i )
         cells->Decrement(h[i] % cells->Size());
@@ -294,7 +298,8 @@ bool CountingBloomFilter::Decrement(const zeek::detail::HashKey* key) {
 }
 
 size_t CountingBloomFilter::Count(const zeek::detail::HashKey* key) const {
-    detail::Hasher::digest_vector h = hasher->Hash(key);
+    hasher->Hash(key, &digests);
+    const auto& h = digests;
 
     detail::CounterVector::size_type min = std::numeric_limits<detail::CounterVector::size_type>::max();
 
@@ -131,6 +131,10 @@ protected:
     virtual BloomFilterType Type() const = 0;
 
     const detail::Hasher* hasher;
+
+    // Scratch space for the hashes of the element currently being added or
+    // looked up, kept around to avoid an allocation per element.
+    mutable detail::Hasher::digest_vector digests;
 };
 
 class CountingBloomFilter;
@@ -2,6 +2,8 @@
 
 #include "zeek/probabilistic/CardinalityCounter.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <utility>
@@ -31,6 +33,9 @@ int CardinalityCounter::OptimalB(double error, double confidence) const {
 void CardinalityCounter::Init(uint64_t size) {
     m = size;
 
+    if ( m == 0 || (m & (m - 1)) != 0 )
+        reporter->InternalError("Invalid size %" PRIu64 ". Size has to be a power of two", size);
+
     // The following magic values are taken directly out of the
     // description of the HyperLogLog algorithm.
 
@@ -111,7 +116,9 @@ uint8_t CardinalityCounter::Rank(uint64_t hash_modified) const {
 }
 
 void CardinalityCounter::AddElement(uint64_t hash) {
-    uint64_t index = hash % m;
+    // m is a power of two, so masking yields the same index as hash % m
+    // without the division.
+    uint64_t index = hash & (m - 1);
     hash = hash - index;
 
     if ( buckets[index] == 0 )
@@ -133,9 +140,18 @@ void CardinalityCounter::AddElement(uint64_t hash) {
  * of our 64-bit hashes.
  **/
 double CardinalityCounter::Size() const {
+    // Bucket values are ranks below 64, so 2^-rank comes from a table
+    // rather than a pow() call per bucket.
+    static const auto inverse_powers = []() {
+        std::array<double, 256> rval;
+        for ( size_t i = 0; i < rval.size(); ++i )
+            rval[i] = std::ldexp(1.0, -static_cast<int>(i));
+        return rval;
+    }();
+
     double answer = 0;
-    for ( unsigned int i = 0; i < m; i++ )
-        answer += pow(2, -((int)buckets[i]));
+    for ( auto bucket : buckets )
+        answer += inverse_powers[bucket];
 
     answer = 1 / answer;
     answer = (alpha_m * m * m * answer);
@@ -154,17 +170,15 @@ bool CardinalityCounter::Merge(CardinalityCounter* c) {
     if ( m != c->GetM() )
         return false;
 
-    const std::vector<uint8_t>& temp = c->GetBuckets();
-
-    V = 0;
+    const uint8_t* other = c->GetBuckets().data();
+    uint8_t* own = buckets.data();
 
-    for ( size_t i = 0; i < m; i++ ) {
-        if ( temp[i] > buckets[i] )
-            buckets[i] = temp[i];
+    // Kept free of branches and of the zero count below so that the
+    // compiler can vectorize it.
+    for ( size_t i = 0; i < m; i++ )
+        own[i] = std::max(own[i], other[i]);
 
-        if ( buckets[i] == 0 )
-            ++V;
-    }
+    V = std::count(buckets.begin(), buckets.end(), 0);
 
     return true;
 }
@@ -197,6 +211,10 @@ std::unique_ptr<CardinalityCounter> CardinalityCounter::Unserialize(BrokerDataVi
     auto [m, V] = to_count(v[0], v[1]);
     auto alpha_m = v[2].ToReal();
 
+    // AddElement() relies on m being a power of two.
+    if ( m == 0 || (m & (m - 1)) != 0 )
+        return nullptr;
+
     if ( v.Size() != 3 + m )
         return nullptr;
 
@@ -258,8 +276,12 @@ int CardinalityCounter::flsll(uint64_t mask) {
 
     if ( mask == 0 )
         return (0);
+#if defined(__GNUC__) || defined(__clang__)
+    bit = 64 - __builtin_clzll(mask);
+#else
     for ( bit = 1; mask != 1; bit++ )
         mask = (uint64_t)mask >> 1;
+#endif
     return (bit);
 }
 
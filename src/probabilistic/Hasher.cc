@@ -103,12 +103,16 @@ DefaultHasher::DefaultHasher(size_t k, Hasher::seed_t seed) : Hasher(k, seed) {
 }
 
 Hasher::digest_vector DefaultHasher::Hash(const void* x, size_t n) const {
-    digest_vector h(K(), 0);
+    digest_vector h;
+    Hash(x, n, &h);
+    return h;
+}
 
-    for ( size_t i = 0; i < h.size(); ++i )
-        h[i] = hash_functions[i](x, n);
+void DefaultHasher::Hash(const void* x, size_t n, digest_vector* h) const {
+    h->resize(K());
 
-    return h;
+    for ( size_t i = 0; i < h->size(); ++i )
+        (*h)[i] = hash_functions[i](x, n);
 }
 
 DefaultHasher* DefaultHasher::Clone() const { return new DefaultHasher(*this); }
@@ -125,14 +129,18 @@ DoubleHasher::DoubleHasher(size_t k, seed_t seed)
     : Hasher(k, seed), h1(seed + util::detail::prng(1)), h2(seed + util::detail::prng(2)) {}
 
 Hasher::digest_vector DoubleHasher::Hash(const void* x, size_t n) const {
+    digest_vector h;
+    Hash(x, n, &h);
+    return h;
+}
+
+void DoubleHasher::Hash(const void* x, size_t n, digest_vector* h) const {
     digest d1 = h1(x, n);
     digest d2 = h2(x, n);
-    digest_vector h(K(), 0);
+    h->resize(K());
 
-    for ( size_t i = 0; i < h.size(); ++i )
-        h[i] = d1 + i * d2;
-
-    return h;
+    for ( size_t i = 0; i < h->size(); ++i )
+        (*h)[i] = d1 + i * d2;
 }
 
 DoubleHasher* DoubleHasher::Clone() const { return new DoubleHasher(*this); }
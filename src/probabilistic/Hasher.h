@@ -87,6 +87,28 @@ public:
      */
     virtual digest_vector Hash(const void* x, size_t n) const = 0;
 
+    /**
+     * Computes the hashes for a set of bytes into an existing vector. This
+     * lets callers hashing many elements reuse the vector's storage instead
+     * of allocating a new one per element.
+     *
+     * @param x Pointer to first byte to hash.
+     *
+     * @param n Number of bytes to hash.
+     *
+     * @param h The vector receiving the *k* hash values.
+     */
+    virtual void Hash(const void* x, size_t n, digest_vector* h) const { *h = Hash(x, n); }
+
+    /**
+     * Computes hash values for an element into an existing vector.
+     *
+     * @param key The key of the value to hash.
+     *
+     * @param h The vector receiving the *k* hash values.
+     */
+    void Hash(const zeek::detail::HashKey* key, digest_vector* h) const { Hash(key->Key(), key->Size(), h); }
+
     /**
      * Returns a deep copy of the hasher.
      */
@@ -206,6 +228,7 @@ public:
 
     // Overridden from Hasher.
     digest_vector Hash(const void* x, size_t n) const final;
+    void Hash(const void* x, size_t n, digest_vector* h) const final;
     DefaultHasher* Clone() const final;
     bool Equals(const Hasher* other) const final;
 
@@ -234,6 +257,7 @@ public:
 
     // Overridden from Hasher.
     digest_vector Hash(const void* x, size_t n) const final;
+    void Hash(const void* x, size_t n, digest_vector* h) const final;
     DoubleHasher* Clone() const final;
     bool Equals(const Hasher* other) const final;
 
@@ -11,11 +11,6 @@
 
 namespace zeek::probabilistic::detail {
 
-static void topk_element_hash_delete_func(void* val) {
-    Element* e = (Element*)val;
-    delete e;
-}
-
 void TopkVal::Typify(TypePtr t) {
     assert(! hash && ! type);
     type = std::move(t);
@@ -32,7 +27,6 @@ zeek::detail::HashKey* TopkVal::GetHash(Val* v) const {
 
 TopkVal::TopkVal(uint64_t arg_size) : OpaqueVal(topk_type) {
     elementDict = new PDict<Element>;
-    elementDict->SetDeleteFunc(topk_element_hash_delete_func);
     size = arg_size;
     numElements = 0;
     pruned = false;
@@ -41,24 +35,110 @@ TopkVal::TopkVal(uint64_t arg_size) : OpaqueVal(topk_type) {
 
 TopkVal::TopkVal() : OpaqueVal(topk_type) {
     elementDict = new PDict<Element>;
-    elementDict->SetDeleteFunc(topk_element_hash_delete_func);
     size = 0;
     numElements = 0;
     hash = nullptr;
 }
 
 TopkVal::~TopkVal() {
+    // The elements themselves are owned by the elements deque.
     elementDict->Clear();
     delete elementDict;
+    delete hash;
+}
+
+Element* TopkVal::NewElement() {
+    if ( free_elements.empty() )
+        return &elements.emplace_back();
+
+    Element* e = free_elements.back();
+    free_elements.pop_back();
+    return e;
+}
+
+void TopkVal::FreeElement(Element* e) {
+    e->value = nullptr;
+    free_elements.push_back(e);
+}
+
+uint32_t TopkVal::NewBucket(uint64_t count, uint32_t before) {
+    uint32_t b;
 
-    // now all elements are already gone - delete the buckets
-    std::list<Bucket*>::iterator bi = buckets.begin();
-    while ( bi != buckets.end() ) {
-        delete *bi;
-        bi++;
+    if ( free_buckets.empty() ) {
+        b = buckets.size();
+        buckets.emplace_back();
+    }
+    else {
+        b = free_buckets.back();
+        free_buckets.pop_back();
+        buckets[b] = Bucket{};
     }
 
-    delete hash;
+    uint32_t after = before == NO_BUCKET ? max_bucket : buckets[before].prev;
+    buckets[b].count = count;
+    buckets[b].prev = after;
+    buckets[b].next = before;
+
+    if ( after == NO_BUCKET )
+        min_bucket = b;
+    else
+        buckets[after].next = b;
+
+    if ( before == NO_BUCKET )
+        max_bucket = b;
+    else
+        buckets[before].prev = b;
+
+    return b;
+}
+
+void TopkVal::AppendToBucket(Element* e, uint32_t b) {
+    Bucket& bucket = buckets[b];
+    e->bucket = b;
+    e->prev = bucket.tail;
+    e->next = nullptr;
+
+    if ( bucket.tail )
+        bucket.tail->next = e;
+    else
+        bucket.head = e;
+
+    bucket.tail = e;
+    ++bucket.num_elements;
+}
+
+void TopkVal::RemoveFromBucket(Element* e) {
+    uint32_t b = e->bucket;
+    Bucket& bucket = buckets[b];
+
+    if ( e->prev )
+        e->prev->next = e->next;
+    else
+        bucket.head = e->next;
+
+    if ( e->next )
+        e->next->prev = e->prev;
+    else
+        bucket.tail = e->prev;
+
+    e->prev = e->next = nullptr;
+    e->bucket = NO_BUCKET;
+
+    if ( --bucket.num_elements > 0 )
+        return;
+
+    // The bucket is empty now, unlink it.
+    if ( bucket.prev == NO_BUCKET )
+        min_bucket = bucket.next;
+    else
+        buckets[bucket.prev].next = bucket.next;
+
+    if ( bucket.next == NO_BUCKET )
+        max_bucket = bucket.prev;
+    else
+        buckets[bucket.next].prev = bucket.prev;
+
+    free_buckets.push_back(b);
 }
 
 void TopkVal::Merge(const TopkVal* value, bool doPrune) {
@@ -80,34 +160,27 @@ void TopkVal::Merge(const TopkVal* value, bool doPrune) {
         }
     }
 
-    std::list<Bucket*>::const_iterator it = value->buckets.begin();
-    while ( it != value->buckets.end() ) {
-        Bucket* b = *it;
-        uint64_t currcount = b->count;
-        std::list<Element*>::const_iterator eit = b->elements.begin();
+    // Elements get merged in place, in order of increasing count, so that
+    // the merged structure never has to be rebuilt.
+    for ( uint32_t b = value->min_bucket; b != NO_BUCKET; b = value->buckets[b].next ) {
+        uint64_t currcount = value->buckets[b].count;
 
-        while ( eit != b->elements.end() ) {
-            Element* e = *eit;
+        for ( const Element* e = value->buckets[b].head; e; e = e->next ) {
             // lookup if we already know this one...
             zeek::detail::HashKey* key = GetHash(e->value);
             Element* olde = (Element*)elementDict->Lookup(key);
 
             if ( olde == nullptr ) {
-                olde = new Element();
+                olde = NewElement();
                 olde->epsilon = 0;
                 olde->value = e->value;
+
                 // insert at bucket position 0
-                if ( buckets.size() > 0 ) {
-                    assert(buckets.front()->count > 0);
+                if ( min_bucket != NO_BUCKET ) {
+                    assert(buckets[min_bucket].count > 0);
                 }
 
-                Bucket* newbucket = new Bucket();
-                newbucket->count = 0;
-                newbucket->bucketPos = buckets.insert(buckets.begin(), newbucket);
-
-                olde->parent = newbucket;
-                newbucket->elements.insert(newbucket->elements.end(), olde);
-
+                AppendToBucket(olde, NewBucket(0, min_bucket));
                 elementDict->Insert(key, olde);
                 numElements++;
             }
@@ -118,11 +191,7 @@ void TopkVal::Merge(const TopkVal* value, bool doPrune) {
             // and increment position...
             IncrementCounter(olde, currcount);
             delete key;
-
-            eit++;
         }
-
-        it++;
     }
 
     // now we have added everything. And our top-k table could be too big.
@@ -135,23 +204,16 @@ void TopkVal::Merge(const TopkVal* value, bool doPrune) {
 
     while ( numElements > size ) {
         pruned = true;
-        assert(buckets.size() > 0);
-        Bucket* b = buckets.front();
-        assert(b->elements.size() > 0);
+        assert(min_bucket != NO_BUCKET);
+        Element* e = buckets[min_bucket].head;
+        assert(e);
 
-        Element* e = b->elements.front();
         zeek::detail::HashKey* key = GetHash(e->value);
         elementDict->RemoveEntry(key);
         delete key;
-        delete e;
-
-        b->elements.pop_front();
-
-        if ( b->elements.size() == 0 ) {
-            delete b;
-            buckets.pop_front();
-        }
 
+        RemoveFromBucket(e);
+        FreeElement(e);
         numElements--;
     }
 }
@@ -176,22 +238,17 @@ VectorValPtr TopkVal::GetTopK(int k) const // returns vector
     // in any case - just to make this future-proof (and I am lazy) - this can return more than k.
 
     int read = 0;
-    std::list<Bucket*>::const_iterator it = buckets.end();
-    it--;
+    uint32_t b = max_bucket;
     while ( read < k ) {
-        // printf("Bucket %llu\n", (*it)->count);
-        std::list<Element*>::iterator eit = (*it)->elements.begin();
-        while ( eit != (*it)->elements.end() ) {
-            // printf("Size: %ld\n", (*it)->elements.size());
-            t->Assign(read, (*eit)->value);
+        for ( const Element* e = buckets[b].head; e; e = e->next ) {
+            t->Assign(read, e->value);
             read++;
-            eit++;
         }
 
-        if ( it == buckets.begin() )
+        if ( b == min_bucket )
             break;
 
-        it--;
+        b = buckets[b].prev;
     }
 
     return t;
@@ -207,7 +264,7 @@ uint64_t TopkVal::GetCount(Val* value) const {
         return 0;
     }
 
-    return e->parent->count;
+    return buckets[e->bucket].count;
 }
 
 uint64_t TopkVal::GetEpsilon(Val* value) const {
@@ -226,12 +283,8 @@ uint64_t TopkVal::GetEpsilon(Val* value) const {
 uint64_t TopkVal::GetSum() const {
     uint64_t sum = 0;
 
-    std::list<Bucket*>::const_iterator it = buckets.begin();
-    while ( it != buckets.end() ) {
-        sum += (*it)->elements.size() * (*it)->count;
-
-        it++;
-    }
+    for ( uint32_t b = min_bucket; b != NO_BUCKET; b = buckets[b].next )
+        sum += buckets[b].num_elements * buckets[b].count;
 
     if ( pruned )
         reporter->Warning(
@@ -256,26 +309,18 @@ void TopkVal::Encountered(ValPtr encountered) {
     Element* e = (Element*)elementDict->Lookup(key);
 
     if ( e == nullptr ) {
-        e = new Element();
-        e->epsilon = 0;
-        e->value = std::move(encountered);
-
         // well, we do not know this one yet...
         if ( numElements < size ) {
+            e = NewElement();
+            e->epsilon = 0;
+            e->value = std::move(encountered);
+
             // brilliant. just add it at position 1
-            if ( buckets.size() == 0 || (*buckets.begin())->count > 1 ) {
-                Bucket* b = new Bucket();
-                b->count = 1;
-                std::list<Bucket*>::iterator pos = buckets.insert(buckets.begin(), b);
-                b->bucketPos = pos;
-                b->elements.insert(b->elements.end(), e);
-                e->parent = b;
-            }
+            if ( min_bucket == NO_BUCKET || buckets[min_bucket].count > 1 )
+                AppendToBucket(e, NewBucket(1, min_bucket));
             else {
-                Bucket* b = *buckets.begin();
-                assert(b->count == 1);
-                b->elements.insert(b->elements.end(), e);
-                e->parent = b;
+                assert(buckets[min_bucket].count == 1);
+                AppendToBucket(e, min_bucket);
             }
 
             elementDict->Insert(key, e);
@@ -287,22 +332,30 @@ void TopkVal::Encountered(ValPtr encountered) {
 
         else {
             // replace element with min-value
-            Bucket* b = *buckets.begin(); // bucket with smallest elements
+            Bucket& b = buckets[min_bucket]; // bucket with smallest elements
 
-            // evict oldest element with least hits.
-            assert(b->elements.size() > 0);
-            zeek::detail::HashKey* deleteKey = GetHash((*(b->elements.begin()))->value);
-            b->elements.erase(b->elements.begin());
+            // evict oldest element with least hits, and reuse it for the
+            // new one.
+            e = b.head;
+            assert(e);
+            zeek::detail::HashKey* deleteKey = GetHash(e->value);
             Element* deleteElement = (Element*)elementDict->RemoveEntry(deleteKey);
-            assert(deleteElement); // there has to have been a minimal element...
-            delete deleteElement;
+            assert(deleteElement == e); // there has to have been a minimal element...
             delete deleteKey;
 
-            // and add the new one to the end
-            e->epsilon = b->count;
-            b->elements.insert(b->elements.end(), e);
+            // and move it to the end of the bucket
+            if ( e != b.tail ) {
+                b.head = e->next;
+                b.head->prev = nullptr;
+                e->prev = b.tail;
+                e->next = nullptr;
+                b.tail->next = e;
+                b.tail = e;
+            }
+
+            e->epsilon = b.count;
+            e->value = std::move(encountered);
             elementDict->Insert(key, e);
-            e->parent = b;
 
             // fallthrough, increment operation has to run!
         }
@@ -314,48 +367,35 @@ void TopkVal::Encountered(ValPtr encountered) {
 }
 
 // increment by count
-void TopkVal::IncrementCounter(Element* e, unsigned int count) {
-    Bucket* currBucket = e->parent;
-    uint64_t currcount = currBucket->count;
+void TopkVal::IncrementCounter(Element* e, uint64_t count) {
+    uint32_t currBucket = e->bucket;
+    uint64_t newcount = buckets[currBucket].count + count;
 
-    // well, let's test if there is a bucket for currcount++
-    std::list<Bucket*>::iterator bucketIter = currBucket->bucketPos;
+    // well, let's test if there is a bucket for currcount + count
+    uint32_t nextBucket = buckets[currBucket].next;
 
-    Bucket* nextBucket = nullptr;
+    while ( nextBucket != NO_BUCKET && buckets[nextBucket].count < newcount )
+        nextBucket = buckets[nextBucket].next;
 
-    bucketIter++;
+    bool have_bucket = nextBucket != NO_BUCKET && buckets[nextBucket].count == newcount;
 
-    while ( bucketIter != buckets.end() && (*bucketIter)->count < currcount + count )
-        bucketIter++;
-
-    if ( bucketIter != buckets.end() && (*bucketIter)->count == currcount + count )
-        nextBucket = *bucketIter;
+    // An element that is alone in its bucket can simply take the bucket
+    // along, unless that would overtake another bucket or there already is
+    // one for the new count.
+    if ( buckets[currBucket].num_elements == 1 && nextBucket == buckets[currBucket].next && ! have_bucket ) {
+        buckets[currBucket].count = newcount;
+        return;
+    }
 
-    if ( nextBucket == nullptr ) {
+    if ( ! have_bucket )
         // the bucket for the value that we want does not exist.
         // create it...
+        nextBucket = NewBucket(newcount, nextBucket);
 
-        Bucket* b = new Bucket();
-        b->count = currcount + count;
-
-        std::list<Bucket*>::iterator nextBucketPos = buckets.insert(bucketIter, b);
-        b->bucketPos = nextBucketPos; // and give it the iterator we know now.
-
-        nextBucket = b;
-    }
-
-    // ok, now we have the new bucket in nextBucket. Shift the element over...
-    currBucket->elements.remove(e);
-    nextBucket->elements.insert(nextBucket->elements.end(), e);
-
-    e->parent = nextBucket;
-
-    // if currBucket is empty, we have to delete it now
-    if ( currBucket->elements.size() == 0 ) {
-        buckets.remove(currBucket);
-        delete currBucket;
-        currBucket = nullptr;
-    }
+    // ok, now we have the new bucket in nextBucket. Shift the element over,
+    // this also releases currBucket if it is empty now.
+    RemoveFromBucket(e);
+    AppendToBucket(e, nextBucket);
 }
 
 IMPLEMENT_OPAQUE_VALUE(TopkVal)
@@ -379,11 +419,11 @@ std::optional<BrokerData> TopkVal::DoSerializeData() const {
         builder.AddNil();
 
     uint64_t i = 0;
-    for ( const auto* b : buckets ) {
-        builder.AddCount(b->elements.size());
-        builder.AddCount(b->count);
+    for ( uint32_t b = min_bucket; b != NO_BUCKET; b = buckets[b].next ) {
+        builder.AddCount(buckets[b].num_elements);
+        builder.AddCount(buckets[b].count);
 
-        for ( const auto* element : b->elements ) {
+        for ( const Element* element = buckets[b].head; element; element = element->next ) {
             builder.AddCount(element->epsilon);
             BrokerData val;
             if ( ! val.Convert(element->value) )
@@ -446,9 +486,10 @@ bool TopkVal::DoUnserializeData(BrokerDataView data) {
         if ( ! ok )
             return false;
 
-        auto* b = new Bucket();
-        b->count = count;
-        b->bucketPos = buckets.insert(buckets.end(), b);
+        if ( elements_count == 0 )
+            continue;
+
+        auto b = NewBucket(count, NO_BUCKET);
 
         for ( uint64_t j = 0; j < elements_count; j++ ) {
             auto epsilon = nextCount();
@@ -463,12 +504,10 @@ bool TopkVal::DoUnserializeData(BrokerDataView data) {
             if ( ! val )
                 return false;
 
-            Element* e = new Element();
+            Element* e = NewElement();
             e->epsilon = epsilon;
             e->value = std::move(val);
-            e->parent = b;
-
-            b->elements.insert(b->elements.end(), e);
+            AppendToBucket(e, b);
 
             zeek::detail::HashKey* key = GetHash(e->value);
             assert(elementDict->Lookup(key) == nullptr);
@@ -2,7 +2,10 @@
 
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
 
 #include "zeek/OpaqueVal.h"
 #include "zeek/Val.h"
@@ -12,6 +15,11 @@
 // Top-k Elements in Data Streams", by Metwally et al. (2005).
 //
 // Or - to be more precise - it implements an interpretation of it.
+//
+// The stream-summary is kept in flat storage: buckets live in a vector and
+// are linked by index in order of increasing count, elements live in a deque
+// and are linked within their bucket in insertion order. Freed buckets and
+// elements get reused, so updating counts never allocates nodes.
 
 namespace zeek::detail {
 class CompositeHash;
@@ -19,22 +27,26 @@ class CompositeHash;
 
 namespace zeek::probabilistic::detail {
 
-struct Element;
-
-struct Bucket {
-    uint64_t count;
-    std::list<Element*> elements;
-
-    // Iterators only get invalidated for removed elements. This one
-    // points to us - so it is invalid when we are no longer there. Cute,
-    // isn't it?
-    std::list<Bucket*>::iterator bucketPos;
-};
+constexpr uint32_t NO_BUCKET = std::numeric_limits<uint32_t>::max();
 
 struct Element {
-    uint64_t epsilon;
+    uint64_t epsilon = 0;
     ValPtr value;
-    Bucket* parent;
+    // Index of the bucket holding this element.
+    uint32_t bucket = NO_BUCKET;
+    // Neighbours within the bucket, in insertion order.
+    Element* prev = nullptr;
+    Element* next = nullptr;
+};
+
+struct Bucket {
+    uint64_t count = 0;
+    uint64_t num_elements = 0;
+    Element* head = nullptr;
+    Element* tail = nullptr;
+    // Neighbouring buckets, in order of increasing count.
+    uint32_t prev = NO_BUCKET;
+    uint32_t next = NO_BUCKET;
 };
 
 class TopkVal : public OpaqueVal {
@@ -148,7 +160,40 @@ private:
      *
      * @param count increment counter by this much
      */
-    void IncrementCounter(Element* e, unsigned int count = 1);
+    void IncrementCounter(Element* e, uint64_t count = 1);
+
+    /**
+     * Returns an unused element, reusing a freed one if possible.
+     */
+    Element* NewElement();
+
+    /**
+     * Releases an element that is no longer linked into a bucket.
+     */
+    void FreeElement(Element* e);
+
+    /**
+     * Creates a bucket and links it in before another one.
+     *
+     * @param count the count of the new bucket
+     *
+     * @param before the bucket to insert in front of, or NO_BUCKET to
+     * append the new bucket at the end
+     *
+     * @returns index of the new bucket
+     */
+    uint32_t NewBucket(uint64_t count, uint32_t before);
+
+    /**
+     * Appends an element to the end of a bucket.
+     */
+    void AppendToBucket(Element* e, uint32_t b);
+
+    /**
+     * Unlinks an element from its bucket, releasing the bucket if it
+     * becomes empty.
+     */
+    void RemoveFromBucket(Element* e);
 
     /**
      * get the hashkey for a specific value
@@ -169,7 +214,13 @@ private:
 
     TypePtr type;
     zeek::detail::CompositeHash* hash = nullptr;
-    std::list<Bucket*> buckets;
+    std::vector<Bucket> buckets;
+    std::vector<uint32_t> free_buckets;
+    uint32_t min_bucket = NO_BUCKET;
+    uint32_t max_bucket = NO_BUCKET;
+    // A deque keeps elements at stable addresses for elementDict.
+    std::deque<Element> elements;
+    std::vector<Element*> free_elements;
     PDict<Element>* elementDict = nullptr;
     uint64_t size = 0;        // how many elements are we tracking?
     uint64_t numElements = 0; // how many elements do we have at the moment
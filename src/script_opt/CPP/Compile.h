@@ -125,7 +125,7 @@ namespace zeek::detail {
 class CPPCompile {
 public:
     CPPCompile(std::vector<FuncInfo>& _funcs, std::shared_ptr<ProfileFuncs> pfs, const std::string& gen_name,
-               bool _standalone, bool report_uncompilable);
+               bool _standalone, std::string _plugin_name, bool report_uncompilable);
     ~CPPCompile();
 
     // Constructing a CPPCompile object does all of the compilation.
@@ -336,6 +336,10 @@ private:
     // If true, the generated code should run "standalone".
     bool standalone = false;
 
+    // If non-empty, the generated code is packaged as a dynamic plugin
+    // with this name.
+    std::string plugin_name;
+
     // Hash over the functions in this compilation.  This is only
     // needed for "seatbelts", to ensure that we can produce a
     // unique hash relating to this compilation (*and* its
@@ -995,6 +999,10 @@ private:
     // Generates code to activate standalone code.
     void GenStandaloneActivation();
 
+    // Generates the plugin scaffolding for code compiled using
+    // "-O gen-C++-plugin".
+    void GenPlugin();
+
     // Generates code to register the initialization for standalone
     // use, and prints to stdout a Zeek script that can load all of
     // what we compiled.
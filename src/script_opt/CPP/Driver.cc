@@ -14,8 +14,8 @@ namespace zeek::detail {
 using namespace std;
 
 CPPCompile::CPPCompile(vector<FuncInfo>& _funcs, std::shared_ptr<ProfileFuncs> _pfs, const string& gen_name,
-                       bool _standalone, bool report_uncompilable)
-    : funcs(_funcs), pfs(std::move(_pfs)), standalone(_standalone) {
+                       bool _standalone, string _plugin_name, bool report_uncompilable)
+    : funcs(_funcs), pfs(std::move(_pfs)), standalone(_standalone), plugin_name(std::move(_plugin_name)) {
     auto target_name = gen_name.c_str();
 
     write_file = fopen(target_name, "w");
@@ -174,6 +174,9 @@ void CPPCompile::Compile(bool report_uncompilable) {
 void CPPCompile::GenProlog() {
     Emit("#include \"zeek/script_opt/CPP/Runtime.h\"\n");
 
+    if ( ! plugin_name.empty() )
+        Emit("#include \"zeek/plugin/Plugin.h\"\n");
+
     // Get the working directory for annotating the output to help
     // with debugging.
     char working_dir[8192];
@@ -331,6 +334,9 @@ void CPPCompile::GenEpilog() {
 
     GenInitHook();
 
+    if ( ! plugin_name.empty() )
+        GenPlugin();
+
     Emit("} //\n\n");
     Emit("} // zeek::detail");
 }
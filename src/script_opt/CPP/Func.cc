@@ -15,6 +15,7 @@ unordered_map<p_hash_type, CompiledScript> compiled_scripts;
 unordered_map<string, unordered_set<p_hash_type>> added_bodies;
 unordered_map<p_hash_type, void (*)()> standalone_callbacks;
 vector<void (*)()> standalone_finalizations;
+bool CPP_plugin_bodies = false;
 
 void CPPFunc::Describe(ODesc* d) const {
     d->AddSP("compiled function");
@@ -117,6 +117,12 @@ extern std::unordered_map<p_hash_type, void (*)()> standalone_callbacks;
 // Callbacks to finalize initialization of standalone compiled scripts.
 extern std::vector<void (*)()> standalone_finalizations;
 
+// True if compiled script bodies were loaded via a dynamic plugin
+// (generated using "-O gen-C++-plugin").  In that case, the bodies
+// are used without requiring "-O use-C++", but only for those
+// script bodies whose hash matches.
+extern bool CPP_plugin_bodies;
+
 } // namespace detail
 
 } // namespace zeek
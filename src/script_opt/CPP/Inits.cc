@@ -227,6 +227,9 @@ void CPPCompile::GenInitHook() {
     if ( standalone )
         GenLoad();
 
+    if ( ! plugin_name.empty() )
+        Emit("CPP_plugin_bodies = true;");
+
     Emit("return 0;");
     EndBlock();
 
@@ -308,6 +311,31 @@ void CPPCompile::GenStandaloneActivation() {
     EndBlock();
 }
 
+void CPPCompile::GenPlugin() {
+    // The plugin itself doesn't need to do anything beyond announcing
+    // its presence: loading its shared library runs the static
+    // initialization that registers the compiled bodies, which are
+    // then activated when scripts are analyzed.
+    NL();
+    Emit("class Plugin : public zeek::plugin::Plugin");
+    StartBlock();
+    Emit("public:");
+    Emit("zeek::plugin::Configuration Configure() override");
+    StartBlock();
+    Emit("zeek::plugin::Configuration config;");
+    Emit("config.name = \"%s\";", plugin_name);
+    Emit("config.description = \"Script bodies compiled to C++ (hash %s)\";", to_string(total_hash));
+    Emit("config.version.major = 1;");
+    Emit("config.version.minor = 0;");
+    Emit("config.version.patch = 0;");
+    Emit("return config;");
+    EndBlock();
+    EndBlock(true);
+
+    NL();
+    Emit("Plugin plugin;");
+}
+
 void CPPCompile::GenLoad() {
     Emit("register_scripts__CPP(%s, standalone_init__CPP);", Fmt(total_hash));
     printf("global init_CPP_%llu = load_CPP(%llu);\n", total_hash, total_hash);
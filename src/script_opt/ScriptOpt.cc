@@ -33,6 +33,7 @@ static std::vector<FuncInfo> funcs;
 
 static bool generating_CPP = false;
 static std::string CPP_dir; // where to generate C++ code
+static std::string CPP_plugin_name = "CPP::Scripts"; // name for -O gen-C++-plugin
 
 static std::unordered_map<const ScriptFunc*, LambdaExpr*> lambdas;
 static std::unordered_set<const ScriptFunc*> when_lambdas;
@@ -259,6 +260,10 @@ static void init_options() {
     if ( cppd )
         CPP_dir = std::string(cppd) + "/";
 
+    auto cpppn = getenv("ZEEK_CPP_PLUGIN_NAME");
+    if ( cpppn )
+        CPP_plugin_name = cpppn;
+
     // ZAM-related options.
     check_env_opt("ZEEK_DUMP_XFORM", analysis_options.dump_xform);
     check_env_opt("ZEEK_DUMP_UDS", analysis_options.dump_uds);
@@ -277,11 +282,23 @@ static void init_options() {
     // Compile-to-C++-related options.
     check_env_opt("ZEEK_GEN_CPP", analysis_options.gen_CPP);
     check_env_opt("ZEEK_GEN_STANDALONE_CPP", analysis_options.gen_standalone_CPP);
+    check_env_opt("ZEEK_GEN_CPP_PLUGIN", analysis_options.gen_CPP_plugin);
     check_env_opt("ZEEK_COMPILE_ALL", analysis_options.compile_all);
     check_env_opt("ZEEK_REPORT_CPP", analysis_options.report_CPP);
     check_env_opt("ZEEK_USE_CPP", analysis_options.use_CPP);
     check_env_opt("ZEEK_ALLOW_COND", analysis_options.allow_cond);
 
+    if ( analysis_options.gen_CPP_plugin ) {
+        if ( analysis_options.gen_standalone_CPP )
+            reporter->FatalError("\"-O gen-C++-plugin\" incompatible with \"-O gen-standalone-C++\"");
+
+        if ( CPP_plugin_name.find("::") == std::string::npos )
+            reporter->FatalError("C++ plugin name \"%s\" must be of the form \"Namespace::Name\"",
+                                 CPP_plugin_name.c_str());
+
+        analysis_options.gen_CPP = true;
+    }
+
     if ( analysis_options.gen_standalone_CPP )
         analysis_options.gen_CPP = true;
 
@@ -431,8 +448,15 @@ static void use_CPP() {
         }
     }
 
-    if ( num_used == 0 )
-        reporter->FatalError("no C++ functions found to use");
+    if ( num_used == 0 ) {
+        if ( CPP_plugin_bodies )
+            // Plugin-provided bodies are compiled against a particular
+            // version of the scripts; if none match, we simply keep
+            // interpreting.
+            reporter->Warning("no C++ plugin bodies match the loaded scripts");
+        else
+            reporter->FatalError("no C++ functions found to use");
+    }
 }
 
 static void generate_CPP() {
@@ -443,7 +467,11 @@ static void generate_CPP() {
 
     auto pfs = std::make_shared<ProfileFuncs>(funcs, is_CPP_compilable, false);
 
-    CPPCompile cpp(funcs, pfs, gen_name, standalone, report);
+    std::string plugin_name;
+    if ( analysis_options.gen_CPP_plugin )
+        plugin_name = CPP_plugin_name;
+
+    CPPCompile cpp(funcs, pfs, gen_name, standalone, plugin_name, report);
 }
 
 static void analyze_scripts_for_ZAM() {
@@ -501,6 +529,11 @@ static void analyze_scripts_for_ZAM() {
 
     bool did_one = false;
 
+    // Note, this loop has to remain sequential.  Optimizing a body
+    // pushes onto the global scope stack, consults globals such as
+    // checking_reduction and non_reduced_perp, and creates and drops
+    // references to types and identifiers shared across functions,
+    // and none of that reference counting is atomic.
     for ( auto& f : funcs ) {
         if ( ! f.ShouldAnalyze() )
             continue;
@@ -561,6 +594,8 @@ void clear_script_analysis() {
 void analyze_scripts(bool no_unused_warnings) {
     init_options();
 
+    analyze_event_param_usage(funcs);
+
     // Any standalone compiled scripts have already been instantiated
     // at this point, but may require post-loading-of-scripts finalization.
     for ( auto cb : standalone_finalizations )
@@ -573,6 +608,11 @@ void analyze_scripts(bool no_unused_warnings) {
     auto& ofuncs = analysis_options.only_funcs;
     auto& ofiles = analysis_options.only_files;
 
+    // Bodies provided by a C++ plugin get used whenever they match,
+    // unless we're generating new ones.
+    if ( CPP_plugin_bodies && ! generating_CPP )
+        analysis_options.use_CPP = true;
+
     if ( ! analysis_options.activate && ! analysis_options.inliner && ! generating_CPP &&
          ! analysis_options.report_CPP && ! analysis_options.use_CPP ) { // No work to do, avoid profiling overhead.
         if ( ! ofuncs.empty() )
@@ -111,6 +111,11 @@ struct AnalyOpt {
     // of the corresponding script, and not activated by default).
     bool gen_standalone_CPP = false;
 
+    // If true, the C++ should be packaged as a dynamic plugin that can
+    // be built against installed Zeek headers.  Its bodies are activated
+    // automatically, replacing those whose AST hash matches.
+    bool gen_CPP_plugin = false;
+
     // If true, use C++ bodies if available.
     bool use_CPP = false;
 
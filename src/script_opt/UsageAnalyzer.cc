@@ -2,6 +2,10 @@
 
 #include "zeek/script_opt/UsageAnalyzer.h"
 
+#include <algorithm>
+#include <unordered_map>
+
+#include "zeek/EventHandler.h"
 #include "zeek/EventRegistry.h"
 #include "zeek/module_util.h"
 #include "zeek/script_opt/IDOptInfo.h"
@@ -263,4 +267,75 @@ TraversalCode UsageAnalyzer::PreType(const Type* t) {
     return TC_CONTINUE;
 }
 
+namespace {
+
+// Flags which parameters of a single handler body get read.
+class ParamUsageAnalyzer : public TraversalCallback {
+public:
+    ParamUsageAnalyzer(const ScopePtr& scope, std::vector<bool>& arg_used) : used(arg_used) {
+        // The parameters come first among the scope's variables.
+        const auto& vars = scope->OrderedVars();
+        int n = std::min(used.size(), vars.size());
+
+        for ( int i = 0; i < n; ++i )
+            params[vars[i].get()] = i;
+    }
+
+    TraversalCode PreStmt(const Stmt* s) override {
+        if ( s->Tag() == STMT_WHEN )
+            return UseAll();
+
+        return TC_CONTINUE;
+    }
+
+    TraversalCode PreExpr(const Expr* e) override {
+        if ( e->Tag() == EXPR_LAMBDA )
+            return UseAll();
+
+        return TC_CONTINUE;
+    }
+
+    TraversalCode PreID(const ID* id) override {
+        if ( auto it = params.find(id); it != params.end() )
+            used[it->second] = true;
+
+        return TC_CONTINUE;
+    }
+
+private:
+    TraversalCode UseAll() {
+        std::fill(used.begin(), used.end(), true);
+        return TC_ABORTALL;
+    }
+
+    std::vector<bool>& used;
+    std::unordered_map<const ID*, int> params;
+};
+
+} // namespace
+
+void analyze_event_param_usage(const std::vector<FuncInfo>& funcs) {
+    std::unordered_map<EventHandler*, std::vector<bool>> usage;
+
+    for ( const auto& f : funcs ) {
+        auto func = f.Func();
+
+        if ( func->Flavor() != FUNC_FLAVOR_EVENT || ! f.Body() )
+            continue;
+
+        auto eh = event_registry->Lookup(func->Name());
+        if ( ! eh )
+            continue;
+
+        auto nparams = func->GetType()->Params()->NumFields();
+        auto& used = usage.try_emplace(eh, nparams, false).first->second;
+
+        ParamUsageAnalyzer pua(f.Scope(), used);
+        f.Body()->Traverse(&pua);
+    }
+
+    for ( auto& [eh, used] : usage )
+        eh->SetParamUsage(std::move(used));
+}
+
 } // namespace zeek::detail
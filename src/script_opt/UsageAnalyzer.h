@@ -75,4 +75,10 @@ private:
 // not previously known before its declaration in a script).
 extern void register_new_event(const IDPtr& id);
 
+// Determines for each event which of its parameters any of its handler
+// bodies reads, and records the result with the event's EventHandler.
+// Bodies that contain lambdas or "when" statements count as reading all
+// of their parameters, since those capture them in ways we don't track.
+extern void analyze_event_param_usage(const std::vector<FuncInfo>& funcs);
+
 } // namespace zeek::detail
@@ -83,6 +83,15 @@ struct Stem {
 
     /**
      * This performs fork() to initialize the supervised-node structure.
+     *
+     * Nodes are always forked from the pristine Stem, so each one goes
+     * through script parsing, signature loading, and script optimization
+     * on its own.  Forking them instead from a process that already did
+     * this work isn't safe: the results depend on the node's identity
+     * (CLUSTER_NODE feeds `Cluster::node` and any `@if` on the node type
+     * at parse time), and by that point Broker and the telemetry manager
+     * have started threads that don't survive a fork().
+     *
      * There's three possible outcomes:
      *   - return value is SupervisedNode: we are the child process
      *   - return value is True: we are the parent and fork() succeeded
@@ -23,15 +23,14 @@ double Counter::Value() const noexcept {
 
 std::shared_ptr<Counter> CounterFamily::GetOrAdd(Span<const LabelView> labels,
                                                  prometheus::CollectCallbackPtr callback) {
-    prometheus::Labels p_labels = detail::BuildPrometheusLabels(labels);
-
-    auto check = [&](const std::shared_ptr<Counter>& counter) { return counter->CompareLabels(p_labels); };
+    auto key = detail::BuildLabelKey(labels);
 
-    if ( auto it = std::find_if(counters.begin(), counters.end(), check); it != counters.end() )
-        return *it;
+    if ( auto it = counters.find(key); it != counters.end() )
+        return it->second;
 
+    prometheus::Labels p_labels = detail::BuildPrometheusLabels(labels);
     auto counter = std::make_shared<Counter>(family, p_labels, callback);
-    counters.push_back(counter);
+    counters.emplace(std::move(key), counter);
     return counter;
 }
 
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <unordered_map>
 
 #include "zeek/Span.h"
 #include "zeek/telemetry/MetricFamily.h"
@@ -85,7 +86,10 @@ public:
 
 private:
     prometheus::Family<prometheus::Counter>* family;
-    std::vector<CounterPtr> counters;
+
+    // Indexed by BuildLabelKey() of the labels the metric was added
+    // under, so that repeated lookups don't rebuild the full labels.
+    std::unordered_map<std::string, CounterPtr> counters;
 };
 
 using CounterFamilyPtr = std::shared_ptr<CounterFamily>;
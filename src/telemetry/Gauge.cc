@@ -23,15 +23,14 @@ Gauge::Gauge(FamilyType* family, const prometheus::Labels& labels, prometheus::C
 }
 
 std::shared_ptr<Gauge> GaugeFamily::GetOrAdd(Span<const LabelView> labels, prometheus::CollectCallbackPtr callback) {
-    prometheus::Labels p_labels = detail::BuildPrometheusLabels(labels);
-
-    auto check = [&](const std::shared_ptr<Gauge>& gauge) { return gauge->CompareLabels(p_labels); };
+    auto key = detail::BuildLabelKey(labels);
 
-    if ( auto it = std::find_if(gauges.begin(), gauges.end(), check); it != gauges.end() )
-        return *it;
+    if ( auto it = gauges.find(key); it != gauges.end() )
+        return it->second;
 
+    prometheus::Labels p_labels = detail::BuildPrometheusLabels(labels);
     auto gauge = std::make_shared<Gauge>(family, p_labels, callback);
-    gauges.push_back(gauge);
+    gauges.emplace(std::move(key), gauge);
     return gauge;
 }
 
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <unordered_map>
 
 #include "zeek/Span.h"
 #include "zeek/telemetry/MetricFamily.h"
@@ -103,7 +104,10 @@ public:
 
 private:
     prometheus::Family<prometheus::Gauge>* family;
-    std::vector<GaugePtr> gauges;
+
+    // Indexed by BuildLabelKey() of the labels the metric was added
+    // under, so that repeated lookups don't rebuild the full labels.
+    std::unordered_map<std::string, GaugePtr> gauges;
 };
 
 using GaugeFamilyPtr = std::shared_ptr<GaugeFamily>;
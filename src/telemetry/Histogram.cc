@@ -12,15 +12,14 @@ Histogram::Histogram(FamilyType* family, const prometheus::Labels& labels,
     : handle(family->Add(labels, std::move(bounds))), labels(labels) {}
 
 std::shared_ptr<Histogram> HistogramFamily::GetOrAdd(Span<const LabelView> labels) {
-    prometheus::Labels p_labels = detail::BuildPrometheusLabels(labels);
-
-    auto check = [&](const std::shared_ptr<Histogram>& histo) { return histo->CompareLabels(p_labels); };
+    auto key = detail::BuildLabelKey(labels);
 
-    if ( auto it = std::find_if(histograms.begin(), histograms.end(), check); it != histograms.end() )
-        return *it;
+    if ( auto it = histograms.find(key); it != histograms.end() )
+        return it->second;
 
+    prometheus::Labels p_labels = detail::BuildPrometheusLabels(labels);
     auto histogram = std::make_shared<Histogram>(family, p_labels, boundaries);
-    histograms.push_back(histogram);
+    histograms.emplace(std::move(key), histogram);
     return histogram;
 }
 
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <unordered_map>
 
 #include "zeek/Span.h"
 #include "zeek/telemetry/MetricFamily.h"
@@ -69,7 +70,10 @@ public:
 private:
     prometheus::Family<prometheus::Histogram>* family;
     prometheus::Histogram::BucketBoundaries boundaries;
-    std::vector<HistogramPtr> histograms;
+
+    // Indexed by BuildLabelKey() of the labels the metric was added
+    // under, so that repeated lookups don't rebuild the full labels.
+    std::unordered_map<std::string, HistogramPtr> histograms;
 };
 
 using HistogramFamilyPtr = std::shared_ptr<HistogramFamily>;
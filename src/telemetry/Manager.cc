@@ -591,6 +591,14 @@ SCENARIO("telemetry managers provide access to counter families") {
                 CHECK_NE(first, second);
             }
         }
+        WHEN("retrieving a counter family with dashes in label names") {
+            auto family = mgr.CounterFamily("zeek", "dashed", {"x-b", "x_a"}, "test");
+            THEN("GetOrAdd treats dashes like underscores, regardless of label order") {
+                auto first = family->GetOrAdd({{"x-b", "1"}, {"x_a", "2"}});
+                auto second = family->GetOrAdd({{"x_b", "1"}, {"x_a", "2"}});
+                CHECK_EQ(first, second);
+            }
+        }
     }
 }
 
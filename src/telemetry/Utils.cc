@@ -1,5 +1,7 @@
 #include "Utils.h"
 
+#include <algorithm>
+
 #include "zeek/ID.h"
 #include "zeek/Reporter.h"
 #include "zeek/Val.h"
@@ -38,6 +40,20 @@ std::string BuildFullPrometheusName(std::string_view prefix, std::string_view na
     return fn;
 }
 
+static std::string_view endpoint_name() {
+    // The ID isn't there during early initialization yet, so keep
+    // looking until it is.
+    static zeek::detail::IDPtr id;
+
+    if ( ! id )
+        id = id::find("Telemetry::metrics_endpoint_name");
+
+    if ( id && id->GetVal() )
+        return id->GetVal()->AsStringVal()->ToStdStringView();
+
+    return {};
+}
+
 prometheus::Labels BuildPrometheusLabels(Span<const LabelView> labels) {
     prometheus::Labels p_labels;
 
@@ -49,12 +65,45 @@ prometheus::Labels BuildPrometheusLabels(Span<const LabelView> labels) {
     }
 
     if ( ! found_endpoint ) {
-        auto endpoint = id::find_val("Telemetry::metrics_endpoint_name")->AsStringVal();
-        if ( endpoint && endpoint->Len() > 0 )
-            p_labels.emplace("endpoint", endpoint->ToStdString());
+        auto endpoint = endpoint_name();
+        if ( ! endpoint.empty() )
+            p_labels.emplace("endpoint", std::string{endpoint});
     }
 
     return p_labels;
 }
 
+std::string BuildLabelKey(Span<const LabelView> labels) {
+    // Normalize the names first, as BuildPrometheusLabels() does, so that
+    // the order doesn't depend on whether a name uses '-' or '_'.
+    std::vector<std::pair<std::string, std::string_view>> sorted;
+    sorted.reserve(labels.size());
+
+    for ( const auto& [name, value] : labels ) {
+        std::string n{name};
+        std::replace(n.begin(), n.end(), '-', '_');
+        sorted.emplace_back(std::move(n), value);
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string key;
+    bool found_endpoint = false;
+
+    for ( const auto& [name, value] : sorted ) {
+        key.append(name);
+        key.push_back('\0');
+        key.append(value);
+        key.push_back('\0');
+
+        if ( name == "endpoint" )
+            found_endpoint = true;
+    }
+
+    if ( ! found_endpoint )
+        key.append("\1").append(endpoint_name());
+
+    return key;
+}
+
 } // namespace zeek::telemetry::detail
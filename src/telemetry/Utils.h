@@ -2,6 +2,7 @@
 
 #include <prometheus/family.h>
 #include <prometheus/labels.h>
+#include <string>
 #include <string_view>
 
 #include "zeek/Span.h"
@@ -19,6 +20,13 @@ namespace detail {
  */
 prometheus::Labels BuildPrometheusLabels(Span<const LabelView> labels);
 
+/**
+ * Builds a key that identifies a set of labels just like the result of
+ * BuildPrometheusLabels() does, but is cheaper to compute. Metric families
+ * use this to find existing metrics.
+ */
+std::string BuildLabelKey(Span<const LabelView> labels);
+
 /**
  * Builds a full metric name for Prometheus from prefix, name, and unit values.
  */
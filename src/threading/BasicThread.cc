@@ -12,6 +12,8 @@ namespace zeek::threading {
 
 static const int STD_FMT_BUF_LEN = 2048;
 
+thread_local std::string* detail::fmt_buffer_override = nullptr;
+
 uint64_t BasicThread::thread_counter = 0;
 
 BasicThread::BasicThread() {
@@ -49,6 +51,21 @@ void BasicThread::SetOSName(const char* arg_name) {
 }
 
 const char* BasicThread::Fmt(const char* format, ...) {
+    if ( auto* b = detail::fmt_buffer_override ) {
+        va_list al;
+        va_start(al, format);
+        int n = vsnprintf(nullptr, 0, format, al);
+        va_end(al);
+
+        b->resize(n > 0 ? n : 0);
+
+        va_start(al, format);
+        vsnprintf(b->data(), b->size() + 1, format, al);
+        va_end(al);
+
+        return b->c_str();
+    }
+
     if ( buf_len > 10 * STD_FMT_BUF_LEN ) {
         // Shrink back to normal.
         buf = (char*)util::safe_realloc(buf, STD_FMT_BUF_LEN);
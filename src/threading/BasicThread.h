@@ -7,12 +7,21 @@
 #include <atomic>
 #include <cstdint>
 #include <iosfwd>
+#include <string>
 #include <thread>
 
 namespace zeek::threading {
 
 class Manager;
 
+namespace detail {
+
+// If set, Fmt() formats into this buffer rather than the thread's own.
+// MsgThread::HelperScope sets it for the helper thread it covers.
+extern thread_local std::string* fmt_buffer_override;
+
+} // namespace detail
+
 /**
  * Base class for all threads.
  *
@@ -116,7 +125,8 @@ public:
      * A version of zeek::util::fmt() that the thread can safely use.
      *
      * This is safe to call from Run() but must not be used from any
-     * other thread than the current one.
+     * other thread than the current one, except for helpers covered by
+     * a MsgThread::HelperScope.
      */
     const char* Fmt(const char* format, ...) __attribute__((format(printf, 2, 3)));
     ;
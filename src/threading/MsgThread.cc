@@ -285,15 +285,58 @@ std::string MsgThread::BuildMsgWithLocation(const char* msg) {
     return desc.Description();
 }
 
+static thread_local MsgThread::HelperScope* current_helper_scope = nullptr;
+
+MsgThread::HelperScope::HelperScope(const MsgThread* arg_thread) : thread(arg_thread) {
+    assert(! current_helper_scope);
+    current_helper_scope = this;
+    detail::fmt_buffer_override = &fmt_buffer;
+}
+
+MsgThread::HelperScope::~HelperScope() {
+    current_helper_scope = nullptr;
+    detail::fmt_buffer_override = nullptr;
+}
+
+MsgThread::HelperScope* MsgThread::HelperScope::Current(const MsgThread* thread) {
+    if ( current_helper_scope && current_helper_scope->thread == thread )
+        return current_helper_scope;
+
+    return nullptr;
+}
+
+void MsgThread::Report(const HelperScope::Message& m) {
+    switch ( m.level ) {
+        case HelperScope::INFO: Info(m.msg.c_str()); break;
+        case HelperScope::WARNING: Warning(m.msg.c_str()); break;
+        case HelperScope::ERROR: Error(m.msg.c_str()); break;
+    }
+}
+
 void MsgThread::Info(const char* msg) {
+    if ( auto* h = HelperScope::Current(this) ) {
+        h->Collect(HelperScope::INFO, msg);
+        return;
+    }
+
     SendOut(new detail::ReporterMessage(detail::ReporterMessage::INFO, this, BuildMsgWithLocation(msg)));
 }
 
 void MsgThread::Warning(const char* msg) {
+    if ( auto* h = HelperScope::Current(this) ) {
+        h->Collect(HelperScope::WARNING, msg);
+        return;
+    }
+
     SendOut(new detail::ReporterMessage(detail::ReporterMessage::WARNING, this, BuildMsgWithLocation(msg)));
 }
 
 void MsgThread::Error(const char* msg) {
+    if ( auto* h = HelperScope::Current(this) ) {
+        h->Collect(HelperScope::ERROR, msg);
+        return;
+    }
+
     SendOut(new detail::ReporterMessage(detail::ReporterMessage::ERROR, this, BuildMsgWithLocation(msg)));
 }
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "zeek/DebugLogger.h"
 #include "zeek/Flare.h"
@@ -208,6 +211,63 @@ public:
      */
     void GetStats(Stats* stats);
 
+    /**
+     * Lets a thread hand parts of its work to helper threads of its own.
+     * While an instance exists, the OS thread that created it may call
+     * Fmt(), Info(), Warning() and Error() on the MsgThread it covers.
+     * Rather than going out right away, the messages get collected in the
+     * instance, for the MsgThread itself to pass on later through
+     * Report().
+     */
+    class HelperScope {
+    public:
+        enum Level { INFO, WARNING, ERROR };
+
+        struct Message {
+            Level level;
+            uint64_t tag; // as set through SetTag() at the time
+            std::string msg;
+        };
+
+        explicit HelperScope(const MsgThread* thread);
+        ~HelperScope();
+
+        HelperScope(const HelperScope&) = delete;
+        HelperScope& operator=(const HelperScope&) = delete;
+
+        /**
+         * Returns the scope covering the current OS thread as a helper
+         * of the given thread, or null if there's none.
+         */
+        static HelperScope* Current(const MsgThread* thread);
+
+        /**
+         * Sets a tag for subsequently collected messages, for the caller
+         * to associate them with its units of work.
+         */
+        void SetTag(uint64_t arg_tag) { tag = arg_tag; }
+
+        void Collect(Level level, const char* msg) { messages.push_back({level, tag, msg}); }
+
+        /**
+         * Returns the messages collected since the previous call, for a
+         * helper that works on several rounds of work.
+         */
+        std::vector<Message> TakeMessages() { return std::exchange(messages, {}); }
+
+    private:
+        const MsgThread* thread;
+        uint64_t tag = 0;
+        std::vector<Message> messages;
+        std::string fmt_buffer;
+    };
+
+    /**
+     * Reports a message collected by a HelperScope through the
+     * corresponding method. Only the child thread may call this method.
+     */
+    void Report(const HelperScope::Message& m);
+
     /**
      * Overridden from iosource::IOSource.
      */